@@ -0,0 +1,158 @@
+/*
+ * HSTCaptureStream.cpp
+ * Protocol capture for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#include "HSTCaptureStream.h"
+
+static_assert(HST_CAPTURE_BUFFER_SIZE > 0 && HST_CAPTURE_BUFFER_SIZE <= 255,
+    "HST_CAPTURE_BUFFER_SIZE must be between 1 and 255");
+
+// The version number written in the log header.
+constexpr static uint8_t g_logVersion = 1;
+
+// Record types in the log.
+constexpr static uint8_t g_recordData = 1;
+constexpr static uint8_t g_recordFlush = 2;
+constexpr static uint8_t g_recordFrame = 3;
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+HSTCaptureStream::HSTCaptureStream(Stream &target, Print &log) :
+    m_target(target),
+    m_log(log),
+    m_lastRecordTime(0),
+    m_dataTime(0),
+    m_lastByteTime(0),
+    m_dataLength(0)
+{
+}
+
+
+//------------------------------------------------------------------------------
+// Capture functions.
+
+void HSTCaptureStream::begin()
+{
+    m_log.write(reinterpret_cast<const uint8_t *>("HSTC"), 4);
+    m_log.write(g_logVersion);
+    m_log.write(static_cast<uint8_t>(0));
+    m_dataLength = 0;
+    m_lastRecordTime = micros();
+}
+
+void HSTCaptureStream::markFrame()
+{
+    const unsigned long now = micros();
+    writeDataRecord();
+    writeRecordStart(g_recordFrame, now);
+}
+
+
+//------------------------------------------------------------------------------
+// Stream functions.
+
+size_t HSTCaptureStream::write(uint8_t data)
+{
+    const unsigned long now = micros();
+    const size_t result = m_target.write(data);
+    captureByte(data, now);
+    return result;
+}
+
+size_t HSTCaptureStream::write(const uint8_t *buffer, size_t size)
+{
+    const unsigned long now = micros();
+    const size_t result = m_target.write(buffer, size);
+    for (size_t i = 0; i < size; ++i) {
+        captureByte(buffer[i], now);
+    }
+    return result;
+}
+
+void HSTCaptureStream::flush()
+{
+    writeDataRecord();
+
+    const unsigned long start = micros();
+    m_target.flush();
+    const unsigned long duration = micros() - start;
+
+    writeRecordStart(g_recordFlush, start);
+    writeVarint(duration);
+}
+
+int HSTCaptureStream::available()
+{
+    return m_target.available();
+}
+
+int HSTCaptureStream::read()
+{
+    return m_target.read();
+}
+
+int HSTCaptureStream::peek()
+{
+    return m_target.peek();
+}
+
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+void HSTCaptureStream::captureByte(uint8_t data, unsigned long now)
+{
+    if (m_dataLength > 0 && (now - m_lastByteTime) > HST_CAPTURE_GAP_US) {
+        writeDataRecord();
+    }
+
+    if (m_dataLength == 0) {
+        m_dataTime = now;
+    }
+    m_data[m_dataLength++] = data;
+    m_lastByteTime = now;
+
+    if (m_dataLength >= HST_CAPTURE_BUFFER_SIZE) {
+        writeDataRecord();
+    }
+}
+
+void HSTCaptureStream::writeDataRecord()
+{
+    if (m_dataLength == 0) {
+        return;
+    }
+
+    writeRecordStart(g_recordData, m_dataTime);
+    m_log.write(m_dataLength);
+    m_log.write(m_data, m_dataLength);
+    m_dataLength = 0;
+}
+
+void HSTCaptureStream::writeRecordStart(uint8_t type, unsigned long timestamp)
+{
+    m_log.write(type);
+    writeVarint(timestamp - m_lastRecordTime);
+    m_lastRecordTime = timestamp;
+}
+
+void HSTCaptureStream::writeVarint(uint32_t value)
+{
+    while (value >= 0x80) {
+        m_log.write(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    m_log.write(static_cast<uint8_t>(value));
+}
@@ -0,0 +1,151 @@
+/*
+ * HSTCaptureStream.h
+ * Protocol capture for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#ifndef Arduino_HSTCaptureStream_h
+#define Arduino_HSTCaptureStream_h
+
+#include "Arduino.h"
+#include "HSTConfig.h"
+
+inline namespace HST_LAYOUT_NAMESPACE {
+
+// This class passes everything written to it on to the display's serial port, and also
+//  records it in a compact timestamped log. The log can be written to anything derived
+//  from Print, such as a file on an SD card or a second serial port connected to a PC.
+// Pass an object of this class to the HobbytronicsSerialTFT constructor in place of
+//  the serial port. The tools/hstcapture.py script can decode the log afterwards.
+//
+// Log format (all multi-byte values are unsigned LEB128 varints):
+//  - Header: the 4 characters "HSTC", followed by a version byte (1) and a flags byte (0).
+//  - Then any number of records, each starting with a type byte:
+//      1 = Data:  varint time delta, length byte (1-255), then that many bytes of data.
+//      2 = Flush: varint time delta, varint microseconds spent in flush().
+//      3 = Frame: varint time delta.
+//  - Each time delta is the number of microseconds since the previous record, or since
+//     begin() for the first record. For data records, it is the time the first byte
+//     in the record was written.
+//
+// Example usage:
+//      HSTCaptureStream capture(Serial1, Serial);
+//      HobbytronicsSerialTFT tft(capture);
+class HSTCaptureStream : public Stream
+{
+public:
+    //------------------------------------------------------------------------------
+    // Construction / destruction.
+
+    // Initialise this object to send data to target, and record it in log.
+    // Note that this will not open either connection, or write anything to the log
+    //    until begin() is called.
+    // WARNING: It is essential that the provided target and log objects exist for as
+    //    long as this object is trying to talk to them. You must manage this yourself.
+    HSTCaptureStream(Stream &target, Print &log);
+
+
+    //------------------------------------------------------------------------------
+    // Disallowed operations.
+
+    // Default construction is not allowed.
+    HSTCaptureStream() = delete;
+
+    // Copy construction is not permitted.
+    HSTCaptureStream(const HSTCaptureStream &) = delete;
+
+    // Copy assignment is not permitted.
+    void operator = (const HSTCaptureStream &) = delete;
+
+
+    //------------------------------------------------------------------------------
+    // Capture functions.
+
+    /// Write the log header and start timing.
+    /// Call this after opening the log, and before sending anything to the display.
+    void begin();
+
+    /// Record the end of a frame in the log.
+    /// The decoder uses these to split its statistics and rendered images into frames.
+    /// If you never call this, it will treat each flush() as the end of a frame instead.
+    void markFrame();
+
+
+    //------------------------------------------------------------------------------
+    // Stream functions.
+
+    // Write a byte to the target, and record it in the log.
+    size_t write(uint8_t data) override;
+
+    // Write several bytes to the target, and record them in the log.
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    // Make the other write() overloads from Print visible, e.g. write("foo").
+    using Print::write;
+
+    // Wait for the target to finish sending, and record how long it took in the log.
+    // Any data waiting to be written to the log is written first.
+    // Note that this doesn't flush the log itself.
+    void flush() override;
+
+    // These read from the target. Incoming data is not recorded.
+    int available() override;
+    int read() override;
+    int peek() override;
+
+
+private:
+    //------------------------------------------------------------------------------
+    // Internal operations.
+
+    // Add a byte which was written at the specified time to the pending data record.
+    // This writes the pending record to the log first if it's too old, and afterwards
+    //  if it's full.
+    void captureByte(uint8_t data, unsigned long now);
+
+    // Write the pending data record to the log, if it contains anything.
+    void writeDataRecord();
+
+    // Write a record type and the time delta since the previous record to the log.
+    void writeRecordStart(uint8_t type, unsigned long timestamp);
+
+    // Write an unsigned LEB128 varint to the log.
+    void writeVarint(uint32_t value);
+
+
+    //------------------------------------------------------------------------------
+    // Data.
+
+    // The stream we're passing data on to, i.e. the display's serial port.
+    Stream & m_target;
+
+    // Where the log is written.
+    Print & m_log;
+
+    // The value of micros() at the start of the most recent record in the log.
+    unsigned long m_lastRecordTime;
+
+    // The value of micros() when the first byte in m_data was written.
+    unsigned long m_dataTime;
+
+    // The value of micros() when the last byte in m_data was written.
+    unsigned long m_lastByteTime;
+
+    // The number of bytes waiting in m_data.
+    uint8_t m_dataLength;
+
+    // Bytes which have been sent to the target but not yet written to the log.
+    uint8_t m_data[HST_CAPTURE_BUFFER_SIZE];
+};
+
+} //inline namespace HST_LAYOUT_NAMESPACE
+
+#endif //Arduino_HSTCaptureStream_h
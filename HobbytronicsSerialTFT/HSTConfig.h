@@ -0,0 +1,132 @@
+/*
+ * HSTConfig.h
+ * Compile-time options for the HobbytronicsSerialTFT library.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#ifndef Arduino_HSTConfig_h
+#define Arduino_HSTConfig_h
+
+// Each option below can be changed by editing this file, or by defining it on the
+//  compiler command line so that it applies to the library as well as your sketch.
+// For example, in PlatformIO add it to build_flags:
+//      build_flags = -DHST_PROFILING=1
+// Or with arduino-cli:
+//      arduino-cli compile --build-property "compiler.cpp.extra_flags=-DHST_PROFILING=1" ...
+// Note that a #define at the top of your sketch will NOT reach the library's own
+//  source files. HST_LEAN, HST_CONSOLE_COLOURS and HST_CAPTURE_BUFFER_SIZE change the
+//  size of the library's objects, so the sketch and library must agree on them, or
+//  the library would corrupt memory. If they don't, the build fails to link with an
+//  undefined reference to something like hst_lean1_colours1_capture32::HSTConsole.
+
+
+//------------------------------------------------------------------------------
+// Build profile.
+
+// Set this to 1 to trade a little speed and flash for less RAM.
+// It packs the state of each HobbytronicsSerialTFT object into bit fields, and lowers
+//  the defaults of HST_PROFILER_BUCKETS, HST_CONSOLE_COLOURS and HST_CAPTURE_BUFFER_SIZE.
+// Run tools/footprint.py to see what each option costs on a particular board.
+#ifndef HST_LEAN
+#define HST_LEAN 0
+#endif
+
+// Declares a data member as a bit field of the given width, only in the lean profile.
+#if HST_LEAN
+#define HST_BITS(n) : n
+#else
+#define HST_BITS(n)
+#endif
+
+
+//------------------------------------------------------------------------------
+// Latency profiler.
+
+// Set this to 1 to measure how long the main drawing calls block the caller.
+// See HSTProfiler.h for details. When this is 0, none of the profiler is compiled.
+#ifndef HST_PROFILING
+#define HST_PROFILING 0
+#endif
+
+// Number of histogram buckets kept for each profiled call.
+// Bucket n counts calls which took at least 2^(n-1) but less than 2^n microseconds.
+// The last bucket also catches everything slower than that.
+// Each bucket uses 2 bytes of RAM per call type. The default of 20 resolves calls up
+//  to about a quarter of a second.
+#ifndef HST_PROFILER_BUCKETS
+#if HST_LEAN
+#define HST_PROFILER_BUCKETS 16
+#else
+#define HST_PROFILER_BUCKETS 20
+#endif
+#endif
+
+
+//------------------------------------------------------------------------------
+// Text console.
+
+// Set this to 1 for HSTConsole to remember the colours of every character cell, which
+//  uses 1 byte of RAM per cell (416 bytes for the small font in landscape).
+// If this is 0, colour changes still apply to new text, but scrolling only compares
+//  characters, so a line which differs from the one above only in colour won't be redrawn.
+#ifndef HST_CONSOLE_COLOURS
+#if HST_LEAN
+#define HST_CONSOLE_COLOURS 0
+#else
+#define HST_CONSOLE_COLOURS 1
+#endif
+#endif
+
+// The maximum number of character cells HSTConsole will allocate.
+// Consoles which would need more cells than this are given fewer rows.
+// The default is big enough for any font size and rotation. The lean profile doesn't
+//  change it, as a console allocates no more than its font size needs anyway.
+// It must be at least 26, which is one row of the small font in landscape.
+#ifndef HST_CONSOLE_MAX_CELLS
+#define HST_CONSOLE_MAX_CELLS 420
+#endif
+
+static_assert(HST_CONSOLE_MAX_CELLS >= 26,
+    "HST_CONSOLE_MAX_CELLS must be at least 26 (one row of the small font)");
+
+
+//------------------------------------------------------------------------------
+// Protocol capture.
+
+// Number of bytes HSTCaptureStream collects before writing them to the log as one record.
+// Larger values mean less overhead in the log, but use more RAM per capture stream.
+#ifndef HST_CAPTURE_BUFFER_SIZE
+#if HST_LEAN
+#define HST_CAPTURE_BUFFER_SIZE 8
+#else
+#define HST_CAPTURE_BUFFER_SIZE 32
+#endif
+#endif
+
+// If this many microseconds pass between bytes, HSTCaptureStream starts a new record.
+// Each record only has one timestamp, so this sets the resolution of the capture.
+#ifndef HST_CAPTURE_GAP_US
+#define HST_CAPTURE_GAP_US 4000
+#endif
+
+
+//------------------------------------------------------------------------------
+// Layout check.
+
+// Classes whose layout depends on the options above are declared in an inline namespace
+//  named after the option values. Code compiled with different values refers to a
+//  different namespace, so a mismatch between the sketch and the library fails to link.
+// This has no cost in the compiled program.
+#define HST_LAYOUT_NAMESPACE HST_LAYOUT_NAMESPACE_EXPAND(HST_LEAN, HST_CONSOLE_COLOURS, HST_CAPTURE_BUFFER_SIZE)
+#define HST_LAYOUT_NAMESPACE_EXPAND(lean, colours, capture) HST_LAYOUT_NAMESPACE_JOIN(lean, colours, capture)
+#define HST_LAYOUT_NAMESPACE_JOIN(lean, colours, capture) hst_lean##lean##_colours##colours##_capture##capture
+
+#endif //Arduino_HSTConfig_h
@@ -0,0 +1,295 @@
+/*
+ * HSTConsole.cpp
+ * Scrolling text console for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#include "HSTConsole.h"
+
+// The value of m_displayRow which indicates the display's text cursor position is unknown.
+constexpr static uint8_t g_unknownRow = 255;
+
+// The smallest number of unchanged cells which setCell() will skip over.
+// A character position command is 5 bytes, so shorter runs are rewritten instead if
+//  they are already in the right colours.
+constexpr static uint8_t g_minSkipCells = 5;
+
+// Get the number of rows a console can have within HST_CONSOLE_MAX_CELLS.
+// There is always at least 1 row, as the console can't work without one.
+static uint8_t limitRows(uint8_t columns, uint8_t rows)
+{
+    if (rows * columns <= HST_CONSOLE_MAX_CELLS) {
+        return rows;
+    }
+    const uint8_t fitted = HST_CONSOLE_MAX_CELLS / columns;
+    return (fitted > 0) ? fitted : 1;
+}
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+HSTConsole::HSTConsole(HobbytronicsSerialTFT &tft, HSTFontSize size, HSTRotation rtn) :
+    m_tft(tft),
+    m_fontSize(size),
+    m_rotation(rtn),
+    m_columns(getColumns(size, rtn)),
+    m_rows(limitRows(m_columns, getRows(size, rtn))),
+    m_cursorCol(0),
+    m_cursorRow(0),
+    m_displayCol(0),
+    m_displayRow(g_unknownRow),
+    m_colText(HSTColour::White),
+    m_colBackground(HSTColour::Black),
+    m_chars(new uint8_t[m_columns * m_rows])
+#if HST_CONSOLE_COLOURS
+    , m_attrs(new uint8_t[m_columns * m_rows])
+#endif
+{
+}
+
+HSTConsole::~HSTConsole()
+{
+    delete [] m_chars;
+    m_chars = nullptr;
+#if HST_CONSOLE_COLOURS
+    delete [] m_attrs;
+    m_attrs = nullptr;
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// Settings.
+
+uint8_t HSTConsole::getColumns(HSTFontSize size, HSTRotation rtn)
+{
+    const bool portrait = (rtn == HSTRotation::Portrait || rtn == HSTRotation::PortraitInverted);
+    switch (size)
+    {
+    case HSTFontSize::Small:
+        return portrait ? 21 : 26;
+
+    case HSTFontSize::Medium:
+        return portrait ? 10 : 13;
+
+    case HSTFontSize::Large:
+        return portrait ? 7 : 8;
+    }
+    return 0;
+}
+
+uint8_t HSTConsole::getRows(HSTFontSize size, HSTRotation rtn)
+{
+    const bool portrait = (rtn == HSTRotation::Portrait || rtn == HSTRotation::PortraitInverted);
+    switch (size)
+    {
+    case HSTFontSize::Small:
+        return portrait ? 20 : 16;
+
+    case HSTFontSize::Medium:
+        return portrait ? 10 : 8;
+
+    case HSTFontSize::Large:
+        return portrait ? 6 : 5;
+    }
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// Console functions.
+
+void HSTConsole::begin()
+{
+    m_tft.setScreenRotation(m_rotation);
+    m_tft.setFontSize(m_fontSize);
+    clear();
+}
+
+void HSTConsole::clear()
+{
+    const HSTColour oldBackgroundCol = m_tft.getBackgroundColour();
+    m_tft.setBackgroundColour(m_colBackground);
+    m_tft.clearScreen();
+    m_tft.setBackgroundColour(oldBackgroundCol);
+
+    const uint16_t numCells = m_columns * m_rows;
+    memset(m_chars, ' ', numCells);
+#if HST_CONSOLE_COLOURS
+    memset(m_attrs, makeAttr(m_colText, m_colBackground), numCells);
+#endif
+
+    m_cursorCol = 0;
+    m_cursorRow = 0;
+    m_displayRow = g_unknownRow;
+}
+
+size_t HSTConsole::write(uint8_t ch)
+{
+    return write(&ch, 1);
+}
+
+size_t HSTConsole::write(const uint8_t *buffer, size_t size)
+{
+    // Colour changes are sent lazily, so restoring the caller's colours afterwards
+    //  costs nothing unless they draw something else.
+    const HSTColour oldLineCol = m_tft.getLineColour();
+    const HSTColour oldBackgroundCol = m_tft.getBackgroundColour();
+
+    for (size_t i = 0; i < size; ++i) {
+        putChar(buffer[i]);
+    }
+
+    m_tft.setLineColour(oldLineCol);
+    m_tft.setBackgroundColour(oldBackgroundCol);
+    return size;
+}
+
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+void HSTConsole::putChar(uint8_t ch)
+{
+    if (ch == '\n') {
+        newLine();
+        return;
+    }
+
+    if (ch == '\r') {
+        m_cursorCol = 0;
+        return;
+    }
+
+    // Wrapping is deferred until there's something to put on the new line.
+    // This avoids scrolling twice if a line exactly fills the console before a newline.
+    if (m_cursorCol >= m_columns) {
+        newLine();
+    }
+
+    setCell(m_cursorCol, m_cursorRow, ch, makeAttr(m_colText, m_colBackground));
+    ++m_cursorCol;
+}
+
+void HSTConsole::newLine()
+{
+    m_cursorCol = 0;
+    if (m_cursorRow + 1 < m_rows) {
+        ++m_cursorRow;
+    } else {
+        scroll();
+    }
+}
+
+void HSTConsole::scroll()
+{
+    const uint8_t current = makeAttr(m_colText, m_colBackground);
+
+    // Work from the top down, so each source line is read before it is overwritten.
+    for (uint8_t row = 0; row + 1 < m_rows; ++row) {
+        const uint16_t src = (row + 1) * m_columns;
+        for (uint8_t col = 0; col < m_columns; ++col) {
+#if HST_CONSOLE_COLOURS
+            setCell(col, row, m_chars[src + col], m_attrs[src + col]);
+#else
+            setCell(col, row, m_chars[src + col], current);
+#endif
+        }
+    }
+
+    for (uint8_t col = 0; col < m_columns; ++col) {
+        setCell(col, m_rows - 1, ' ', current);
+    }
+}
+
+void HSTConsole::setCell(uint8_t col, uint8_t row, uint8_t ch, uint8_t attr)
+{
+    const uint16_t idx = (row * m_columns) + col;
+#if HST_CONSOLE_COLOURS
+    const bool unchanged = cellsMatch(m_chars[idx], m_attrs[idx], ch, attr);
+    m_attrs[idx] = attr;
+#else
+    // Colours aren't stored, so only the characters can be compared.
+    const bool unchanged = (m_chars[idx] == ch);
+#endif
+    m_chars[idx] = ch;
+    if (unchanged) {
+        return;
+    }
+
+    // The display advances its own cursor after each character, so a run of changed
+    //  cells on the same line only needs one position command.
+    if (m_displayRow != row || m_displayCol != col) {
+#if HST_CONSOLE_COLOURS
+        if (canRewriteGap(col, row, attr)) {
+            for (uint8_t skipped = m_displayCol; skipped < col; ++skipped) {
+                drawCell(skipped, row, m_chars[(row * m_columns) + skipped], attr);
+            }
+        } else {
+            m_tft.gotoCharacterPosition(col, row);
+        }
+#else
+        // Unchanged cells can't be rewritten, as their colours aren't stored.
+        m_tft.gotoCharacterPosition(col, row);
+#endif
+    }
+
+    drawCell(col, row, ch, attr);
+}
+
+#if HST_CONSOLE_COLOURS
+bool HSTConsole::canRewriteGap(uint8_t col, uint8_t row, uint8_t attr) const
+{
+    if (m_displayRow != row || m_displayCol >= col || col - m_displayCol >= g_minSkipCells) {
+        return false;
+    }
+
+    // A cell in a different colour would need colour commands before and after it,
+    //  which cost more than the position command they save.
+    const uint16_t rowStart = row * m_columns;
+    for (uint8_t skipped = m_displayCol; skipped < col; ++skipped) {
+        if (m_attrs[rowStart + skipped] != attr) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+void HSTConsole::drawCell(uint8_t col, uint8_t row, uint8_t ch, uint8_t attr)
+{
+    m_tft.setLineColour(static_cast<HSTColour>(attr & 0x0F));
+    m_tft.setBackgroundColour(static_cast<HSTColour>(attr >> 4));
+    m_tft.write(ch);
+
+    // We don't know how the display wraps its cursor at the end of the line.
+    m_displayCol = col + 1;
+    m_displayRow = (m_displayCol < m_columns) ? row : g_unknownRow;
+}
+
+uint8_t HSTConsole::makeAttr(HSTColour text, HSTColour background)
+{
+    return static_cast<uint8_t>(text) | (static_cast<uint8_t>(background) << 4);
+}
+
+bool HSTConsole::cellsMatch(uint8_t ch1, uint8_t attr1, uint8_t ch2, uint8_t attr2)
+{
+    if (ch1 != ch2) {
+        return false;
+    }
+
+    // The text colour of a space is invisible.
+    if (ch1 == ' ') {
+        return (attr1 >> 4) == (attr2 >> 4);
+    }
+    return attr1 == attr2;
+}
@@ -0,0 +1,201 @@
+/*
+ * HSTConsole.h
+ * Scrolling text console for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#ifndef Arduino_HSTConsole_h
+#define Arduino_HSTConsole_h
+
+#include "HobbytronicsSerialTFT.h"
+
+inline namespace HST_LAYOUT_NAMESPACE {
+
+// This class turns the whole display into a scrolling text console, like a serial monitor.
+// Note that this derives from Print, so text can be sent to the console using the usual
+//    text printing member functions, such as println("foo").
+// The display firmware wraps text without scrolling, so this class keeps a shadow copy of
+//  every character cell on the screen. When the text needs to scroll up, it only rewrites
+//  the cells whose character or colour is different on the new line from the old one.
+// Short runs of unchanged cells between them are rewritten too if they are already in
+//  the right colours, as that is cheaper than moving the display's text cursor past them.
+// The shadow copy uses 2 bytes of RAM per character cell, allocated at construction.
+// That is 832 bytes for the small font in landscape, or 80 bytes for the large font.
+// Setting HST_CONSOLE_COLOURS to 0 in HSTConfig.h halves that, but cells are then
+//  redrawn in the current colours when scrolling.
+class HSTConsole : public Print
+{
+public:
+    //------------------------------------------------------------------------------
+    // Construction / destruction.
+
+    // Initialise the console to use the given display, font size, and screen rotation.
+    // The font size and rotation determine how many character cells fit on the screen.
+    // This doesn't send anything to the display. Call begin() before printing.
+    // WARNING: It is essential that the provided tft object exists for as long
+    //    as this object is trying to draw on it. You must manage this yourself.
+    HSTConsole(HobbytronicsSerialTFT &tft, HSTFontSize size = HSTFontSize::Small, HSTRotation rtn = HSTRotation::Landscape);
+
+    // Destructor.
+    ~HSTConsole();
+
+
+    //------------------------------------------------------------------------------
+    // Disallowed operations.
+
+    // Default construction is not allowed.
+    HSTConsole() = delete;
+
+    // Copy construction is not permitted.
+    HSTConsole(const HSTConsole &) = delete;
+
+    // Copy assignment is not permitted.
+    void operator = (const HSTConsole &) = delete;
+
+
+    //------------------------------------------------------------------------------
+    // Settings.
+
+    /// Set the colour which will be used for subsequent text.
+    /// Default is white.
+    void setTextColour(const HSTColour col) { m_colText = col; }
+
+    /// Same as setTextColour(), but with American spelling.
+    void setTextColor(const HSTColor col) { setTextColour(col); }
+
+    /// Set the background colour which will be used for subsequent text and new lines.
+    /// Default is black.
+    void setBackgroundColour(const HSTColour col) { m_colBackground = col; }
+
+    /// Same as setBackgroundColour(), but with American spelling.
+    void setBackgroundColor(const HSTColor col) { setBackgroundColour(col); }
+
+    /// Get the number of character cells across the console.
+    uint8_t getColumns() const { return m_columns; }
+
+    /// Get the number of lines of text in the console.
+    uint8_t getRows() const { return m_rows; }
+
+    /// Get the number of character cells across the screen for the given font size and rotation.
+    static uint8_t getColumns(HSTFontSize size, HSTRotation rtn);
+
+    /// Get the number of lines of text on the screen for the given font size and rotation.
+    static uint8_t getRows(HSTFontSize size, HSTRotation rtn);
+
+
+    //------------------------------------------------------------------------------
+    // Console functions.
+
+    /// Set the display's font size and rotation to match the console, then clear it.
+    /// Call this once the display is ready to receive commands.
+    void begin();
+
+    /// Clear the screen and move the cursor back to the top-left.
+    /// This uses the console's current background colour.
+    void clear();
+
+    // Write a single character to the console.
+    // A newline character moves to the start of the next line, scrolling if necessary.
+    // A carriage return character moves to the start of the current line.
+    // Note that you can call the print() and println() functions derived from the
+    //  Print class to write strings and numbers.
+    size_t write(uint8_t) override;
+
+    // Write several characters to the console.
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    // Make the other write() overloads from Print visible, e.g. write("foo").
+    using Print::write;
+
+
+private:
+    //------------------------------------------------------------------------------
+    // Internal operations.
+
+    // Handle one character without saving or restoring the display's colours.
+    void putChar(uint8_t ch);
+
+    // Move the cursor to the start of the next line, scrolling if necessary.
+    void newLine();
+
+    // Scroll the contents of the console up by one line, and blank the bottom line.
+    // Only the cells which are different on screen are sent to the display.
+    void scroll();
+
+    // Store a cell in the shadow copy and draw it on the display, if it has changed.
+    void setCell(uint8_t col, uint8_t row, uint8_t ch, uint8_t attr);
+
+#if HST_CONSOLE_COLOURS
+    // Check if the unchanged cells between the display's text cursor and col, row can be
+    //  rewritten more cheaply than moving the cursor past them.
+    bool canRewriteGap(uint8_t col, uint8_t row, uint8_t attr) const;
+#endif
+
+    // Draw a cell at the display's current text cursor, which must be at col, row.
+    void drawCell(uint8_t col, uint8_t row, uint8_t ch, uint8_t attr);
+
+    // Combine a text and background colour into a cell attribute value.
+    static uint8_t makeAttr(HSTColour text, HSTColour background);
+
+    // Check if two cells would look identical on screen.
+    // Spaces are considered identical if they have the same background colour.
+    static bool cellsMatch(uint8_t ch1, uint8_t attr1, uint8_t ch2, uint8_t attr2);
+
+
+    //------------------------------------------------------------------------------
+    // Data.
+
+    // The display we are drawing on.
+    HobbytronicsSerialTFT & m_tft;
+
+    // The font size and rotation the console was created for.
+    HSTFontSize m_fontSize;
+    HSTRotation m_rotation;
+
+    // The size of the console in character cells.
+    // The number of rows may be less than fits on the screen if HST_CONSOLE_MAX_CELLS
+    //  is set lower than the default.
+    uint8_t m_columns;
+    uint8_t m_rows;
+
+    // Position where the next character will be stored.
+    // If m_cursorCol is equal to m_columns then the next printable character wraps
+    //  to a new line first.
+    uint8_t m_cursorCol;
+    uint8_t m_cursorRow;
+
+    // Where we think the display's own text cursor is.
+    // This lets us skip sending a position command when writing consecutive cells.
+    // If m_displayRow is 255 then the position is unknown.
+    uint8_t m_displayCol;
+    uint8_t m_displayRow;
+
+    // The colour used for subsequent text.
+    HSTColour m_colText;
+
+    // The colour used for the background of subsequent text and new lines.
+    HSTColour m_colBackground;
+
+    // Shadow copy of the characters currently on the screen.
+    // It has m_columns * m_rows elements, stored row-by-row.
+    uint8_t * m_chars;
+
+#if HST_CONSOLE_COLOURS
+    // Shadow copy of the colours of each character cell currently on the screen.
+    // Each element is the text colour in the lower 4 bits, and the background colour
+    //  in the upper 4 bits. It is laid out the same as m_chars.
+    uint8_t * m_attrs;
+#endif
+};
+
+} //inline namespace HST_LAYOUT_NAMESPACE
+
+#endif //Arduino_HSTConsole_h
@@ -0,0 +1,169 @@
+/*
+ * HSTProfiler.cpp
+ * On-device latency profiler for the HobbytronicsSerialTFT library.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#include "HSTProfiler.h"
+
+#if HST_PROFILING
+
+// The number of call types which are profiled.
+constexpr static uint8_t g_numCalls = static_cast<uint8_t>(HSTProfileCall::Count);
+
+HSTProfiler::CallStats HSTProfiler::m_stats[g_numCalls];
+
+
+//------------------------------------------------------------------------------
+// Results.
+
+void HSTProfiler::reset()
+{
+    memset(m_stats, 0, sizeof(m_stats));
+}
+
+uint32_t HSTProfiler::getCount(HSTProfileCall call)
+{
+    return m_stats[static_cast<uint8_t>(call)].count;
+}
+
+uint32_t HSTProfiler::getMin(HSTProfileCall call)
+{
+    return m_stats[static_cast<uint8_t>(call)].min;
+}
+
+uint32_t HSTProfiler::getMax(HSTProfileCall call)
+{
+    return m_stats[static_cast<uint8_t>(call)].max;
+}
+
+uint32_t HSTProfiler::getPercentile(HSTProfileCall call, uint8_t percent)
+{
+    const CallStats &stats = m_stats[static_cast<uint8_t>(call)];
+
+    // The buckets may have been halved, so they can total less than getCount().
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < HST_PROFILER_BUCKETS; ++i) {
+        count += stats.buckets[i];
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // Round the target up, so that e.g. the 99th percentile of 10 calls is the slowest one.
+    const uint32_t target = ((count * percent) + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < HST_PROFILER_BUCKETS - 1; ++i) {
+        cumulative += stats.buckets[i];
+        if (cumulative >= target) {
+            const uint32_t upper = (1UL << i) - 1;
+            return (upper < stats.max) ? upper : stats.max;
+        }
+    }
+    return stats.max;
+}
+
+void HSTProfiler::dump(Print &out, bool histograms)
+{
+    out.println(F("call\tcount\tmin\tp50\tp99\tmax\t(us)"));
+    for (uint8_t i = 0; i < g_numCalls; ++i) {
+        const HSTProfileCall call = static_cast<HSTProfileCall>(i);
+        out.print(callName(call));
+        out.print('\t');
+        out.print(getCount(call));
+        out.print('\t');
+        out.print(getMin(call));
+        out.print('\t');
+        out.print(getPercentile(call, 50));
+        out.print('\t');
+        out.print(getPercentile(call, 99));
+        out.print('\t');
+        out.println(getMax(call));
+
+        if (histograms) {
+            // One count per bucket, from fastest to slowest.
+            out.print(F("  buckets:"));
+            for (uint8_t b = 0; b < HST_PROFILER_BUCKETS; ++b) {
+                out.print(' ');
+                out.print(m_stats[i].buckets[b]);
+            }
+            out.println();
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// Recording.
+
+void HSTProfiler::record(HSTProfileCall call, uint32_t duration)
+{
+    CallStats &stats = m_stats[static_cast<uint8_t>(call)];
+    const uint8_t bucket = bucketIndex(duration);
+
+    // Halve everything rather than letting a bucket overflow.
+    if (stats.buckets[bucket] == 0xFFFF) {
+        for (uint8_t i = 0; i < HST_PROFILER_BUCKETS; ++i) {
+            stats.buckets[i] /= 2;
+        }
+    }
+    ++stats.buckets[bucket];
+    ++stats.count;
+
+    if (duration < stats.min || stats.count == 1) {
+        stats.min = duration;
+    }
+    if (duration > stats.max) {
+        stats.max = duration;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+uint8_t HSTProfiler::bucketIndex(uint32_t duration)
+{
+    // The bucket index is the number of significant bits in the duration.
+    uint8_t index = 0;
+    while (duration > 0 && index < HST_PROFILER_BUCKETS - 1) {
+        duration >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+const __FlashStringHelper * HSTProfiler::callName(HSTProfileCall call)
+{
+    switch (call)
+    {
+    case HSTProfileCall::DrawBox:
+        return F("drawBox");
+
+    case HSTProfileCall::DrawCircle:
+        return F("drawCircle");
+
+    case HSTProfileCall::Write:
+        return F("write");
+
+    case HSTProfileCall::Flush:
+        return F("flush");
+
+    case HSTProfileCall::ClearScreen:
+        return F("clearScreen");
+
+    default:
+        break;
+    }
+    return F("?");
+}
+
+#endif //HST_PROFILING
@@ -0,0 +1,159 @@
+/*
+ * HSTProfiler.h
+ * On-device latency profiler for the HobbytronicsSerialTFT library.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#ifndef Arduino_HSTProfiler_h
+#define Arduino_HSTProfiler_h
+
+#include "HSTConfig.h"
+
+#if HST_PROFILING
+
+#include "Arduino.h"
+
+// Enumeration of the library calls which are profiled.
+enum class HSTProfileCall : uint8_t
+{
+    DrawBox = 0,    // HobbytronicsSerialTFT::drawBox()
+    DrawCircle,     // HobbytronicsSerialTFT::drawCircle()
+    Write,          // HobbytronicsSerialTFT::write(), including everything sent by print() and println()
+    Flush,          // HobbytronicsSerialTFT::flush()
+    ClearScreen,    // HobbytronicsSerialTFT::clearScreen()
+    Count           // Not a call. This is the number of profiled calls.
+};
+
+
+// This class records how long each profiled library call blocks the caller.
+// It is only available if HST_PROFILING is set to 1 in HSTConfig.h.
+// Durations are measured with micros(), so the resolution is 4 microseconds on
+//  16MHz boards. They are stored in a histogram of logarithmic buckets for each call
+//  type, which gives a fixed RAM cost no matter how many calls are recorded.
+// The results are shared by all HobbytronicsSerialTFT objects.
+// Example usage: HSTProfiler::dump(Serial)
+class HSTProfiler
+{
+public:
+    //------------------------------------------------------------------------------
+    // Disallowed operations.
+
+    // This class only has static members, so it can't be constructed.
+    HSTProfiler() = delete;
+
+
+    //------------------------------------------------------------------------------
+    // Results.
+
+    /// Discard all recorded durations.
+    static void reset();
+
+    /// Get the number of calls recorded for the specified call type.
+    static uint32_t getCount(HSTProfileCall call);
+
+    /// Get the shortest duration recorded for the specified call type, in microseconds.
+    /// Returns 0 if nothing has been recorded.
+    static uint32_t getMin(HSTProfileCall call);
+
+    /// Get the longest duration recorded for the specified call type, in microseconds.
+    static uint32_t getMax(HSTProfileCall call);
+
+    /// Estimate the specified percentile of durations for the specified call type.
+    /// The result is the upper limit of the histogram bucket containing the percentile,
+    ///  capped at the longest recorded duration.
+    /// Example usage: getPercentile(HSTProfileCall::DrawBox, 99)
+    static uint32_t getPercentile(HSTProfileCall call, uint8_t percent);
+
+    /// Print a table of results for all call types to the specified output.
+    /// This is intended for a secondary serial port, not the display itself.
+    /// If histograms is true then the bucket counts are printed for each call type too.
+    /// Example usage: dump(Serial)
+    static void dump(Print &out, bool histograms = false);
+
+
+    //------------------------------------------------------------------------------
+    // Recording.
+
+    /// Record one call of the specified type which took the specified time.
+    /// The library calls this automatically. You don't normally need to.
+    static void record(HSTProfileCall call, uint32_t duration);
+
+
+private:
+    //------------------------------------------------------------------------------
+    // Internal declarations.
+
+    // Recorded results for a single call type.
+    struct CallStats
+    {
+        // Number of calls which fell into each bucket.
+        // If a bucket fills up then all buckets are halved, so the shape of the
+        //  histogram is kept.
+        uint16_t buckets[HST_PROFILER_BUCKETS];
+
+        // Total number of calls recorded. This isn't affected by halving the buckets.
+        uint32_t count;
+
+        // Shortest and longest durations recorded, in microseconds.
+        uint32_t min;
+        uint32_t max;
+    };
+
+
+    //------------------------------------------------------------------------------
+    // Internal operations.
+
+    // Get the index of the bucket which the specified duration belongs in.
+    static uint8_t bucketIndex(uint32_t duration);
+
+    // Get the name of the specified call type, for printing.
+    static const __FlashStringHelper * callName(HSTProfileCall call);
+
+
+    //------------------------------------------------------------------------------
+    // Data.
+
+    // Recorded results for each call type.
+    static CallStats m_stats[static_cast<uint8_t>(HSTProfileCall::Count)];
+};
+
+
+// This object measures the time from its construction to its destruction, and records
+//  it in the HSTProfiler. It is used by the HST_PROFILE() macro.
+class HSTProfileScope
+{
+public:
+    HSTProfileScope(HSTProfileCall call) : m_call(call), m_start(micros()) {}
+    ~HSTProfileScope() { HSTProfiler::record(m_call, micros() - m_start); }
+
+    HSTProfileScope(const HSTProfileScope &) = delete;
+    void operator = (const HSTProfileScope &) = delete;
+
+private:
+    // The call type being measured.
+    HSTProfileCall m_call;
+
+    // The value of micros() at construction.
+    unsigned long m_start;
+};
+
+// Record how long the rest of the enclosing scope takes, as the specified call type.
+// Example usage: HST_PROFILE(DrawBox);
+#define HST_PROFILE(call) HSTProfileScope hstProfileScope(HSTProfileCall::call)
+
+#else
+
+// Profiling is disabled, so this does nothing.
+#define HST_PROFILE(call)
+
+#endif //HST_PROFILING
+
+#endif //Arduino_HSTProfiler_h
@@ -0,0 +1,228 @@
+/*
+ * HSTStripChart.cpp
+ * Scrolling strip-chart widget for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#include "HSTStripChart.h"
+
+
+//------------------------------------------------------------------------------
+// Construction / destruction.
+
+HSTStripChart::HSTStripChart(HobbytronicsSerialTFT &tft, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int minValue, int maxValue) :
+    m_tft(tft),
+    m_x(x),
+    m_y(y),
+    m_width(width),
+    m_height(height),
+    m_minValue(minValue),
+    m_maxValue(maxValue),
+    m_colTrace(HSTColour::Green),
+    m_colBackground(HSTColour::Black),
+    m_style(HSTChartStyle::Decimate),
+    m_samplesPerColumn(1),
+    m_pendingCount(0),
+    m_pendingTop(0),
+    m_pendingBottom(0),
+    m_cursor(0),
+    m_numColumns(0),
+    m_colTop(new uint8_t[width]),
+    m_colBottom(new uint8_t[width])
+{
+}
+
+HSTStripChart::~HSTStripChart()
+{
+    delete [] m_colTop;
+    m_colTop = nullptr;
+    delete [] m_colBottom;
+    m_colBottom = nullptr;
+}
+
+
+//------------------------------------------------------------------------------
+// Settings.
+
+void HSTStripChart::setSamplesPerColumn(uint8_t samples)
+{
+    m_samplesPerColumn = (samples > 0) ? samples : 1;
+}
+
+
+//------------------------------------------------------------------------------
+// Drawing.
+
+void HSTStripChart::clear()
+{
+    m_pendingCount = 0;
+    m_cursor = 0;
+    m_numColumns = 0;
+    eraseChart();
+}
+
+void HSTStripChart::redraw()
+{
+    if (m_width == 0 || m_height == 0) {
+        return;
+    }
+
+    eraseChart();
+
+    // Once the chart is full, the column at the cursor is the gap between new and old data.
+    // A chart 1 pixel wide has no room for a gap, so its only column is always drawn.
+    const bool full = (m_numColumns == m_width && m_width > 1);
+
+    const HSTColour oldLineCol = m_tft.getLineColour();
+    m_tft.setLineColour(m_colTrace);
+    for (uint8_t col = 0; col < m_numColumns; ++col) {
+        if (full && col == m_cursor) {
+            continue;
+        }
+        drawColumn(col, isJoined(col));
+    }
+
+    // The column after the gap was joined to the old data at the cursor when it was
+    //  drawn, and the sweep only erased the gap itself. Joining it above then erasing
+    //  the gap again leaves the same pixels on screen as the sweep does.
+    if (full) {
+        m_tft.setLineColour(m_colBackground);
+        eraseColumn(m_cursor);
+    }
+    m_tft.setLineColour(oldLineCol);
+}
+
+void HSTStripChart::addSample(int value)
+{
+    if (m_width == 0 || m_height == 0) {
+        return;
+    }
+
+    const uint8_t y = valueToY(value);
+    if (m_pendingCount == 0 || m_style == HSTChartStyle::Decimate) {
+        m_pendingTop = y;
+        m_pendingBottom = y;
+    } else {
+        if (y < m_pendingTop) {
+            m_pendingTop = y;
+        }
+        if (y > m_pendingBottom) {
+            m_pendingBottom = y;
+        }
+    }
+
+    if (++m_pendingCount >= m_samplesPerColumn) {
+        m_pendingCount = 0;
+        commitColumn();
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// Internal operations.
+
+uint8_t HSTStripChart::valueToY(int value) const
+{
+    if (value <= m_minValue) {
+        return m_y + m_height - 1;
+    }
+    if (value >= m_maxValue) {
+        return m_y;
+    }
+
+    // Use long arithmetic, as int is only 16-bit on most Arduinos.
+    const long range = static_cast<long>(m_maxValue) - m_minValue;
+    const long offset = static_cast<long>(value) - m_minValue;
+    const long scaled = (offset * (m_height - 1) + (range / 2)) / range;
+    return m_y + m_height - 1 - static_cast<uint8_t>(scaled);
+}
+
+void HSTStripChart::commitColumn()
+{
+    const uint8_t col = m_cursor;
+    m_colTop[col] = m_pendingTop;
+    m_colBottom[col] = m_pendingBottom;
+
+    m_cursor = (col + 1 < m_width) ? col + 1 : 0;
+    if (m_numColumns < m_width) {
+        ++m_numColumns;
+    }
+
+    const HSTColour oldLineCol = m_tft.getLineColour();
+
+    // The column ahead of the cursor only needs erasing if it contains old data.
+    // Until the chart has filled up once, it is still blank from clear().
+    if (m_numColumns == m_width) {
+        m_tft.setLineColour(m_colBackground);
+        eraseColumn(m_cursor);
+    }
+
+    // The column we're drawing in was erased when the cursor was behind it.
+    m_tft.setLineColour(m_colTrace);
+    drawColumn(col, isJoined(col));
+
+    // Colour changes are sent lazily, so restoring the caller's colour costs nothing here.
+    m_tft.setLineColour(oldLineCol);
+}
+
+void HSTStripChart::eraseChart()
+{
+    if (m_width == 0 || m_height == 0) {
+        return;
+    }
+
+    const HSTColour oldFillCol = m_tft.getFillColour();
+    m_tft.setFillColour(m_colBackground);
+    m_tft.drawBox(m_x, m_y, m_x + m_width - 1, m_y + m_height - 1, HSTShapeStyle::Fill);
+    m_tft.setFillColour(oldFillCol);
+}
+
+void HSTStripChart::eraseColumn(uint8_t col)
+{
+    // Always erase the whole height. It costs the same number of bytes as a shorter
+    //  line, and it catches pixels from lines joining this column to its neighbours.
+    m_tft.drawVerticalLine(m_x + col, m_y, m_y + m_height - 1);
+}
+
+void HSTStripChart::drawColumn(uint8_t col, bool connect)
+{
+    const uint8_t x = m_x + col;
+    uint8_t top = m_colTop[col];
+    uint8_t bottom = m_colBottom[col];
+
+    if (m_style == HSTChartStyle::Decimate) {
+        if (connect) {
+            m_tft.drawLine(x - 1, m_colTop[col - 1], x, top);
+        } else {
+            m_tft.drawPixel(x, top);
+        }
+        return;
+    }
+
+    // Stretch the envelope so that it touches the previous column.
+    // This keeps the trace continuous if the signal jumps between columns.
+    if (connect) {
+        if (top > m_colBottom[col - 1]) {
+            top = m_colBottom[col - 1];
+        }
+        if (bottom < m_colTop[col - 1]) {
+            bottom = m_colTop[col - 1];
+        }
+    }
+    m_tft.drawVerticalLine(x, top, bottom);
+}
+
+bool HSTStripChart::isJoined(uint8_t col) const
+{
+    // The first column isn't joined, as the previous one is at the other end of the chart.
+    // In a chart 2 pixels wide, the previous column is the one erased ahead of the cursor.
+    return col > 0 && m_width > 2;
+}
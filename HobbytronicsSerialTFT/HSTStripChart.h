@@ -0,0 +1,195 @@
+/*
+ * HSTStripChart.h
+ * Scrolling strip-chart widget for the Hobbytronics Serial TFT 1.8 inch display.
+ *
+ * NOTE: This library and the author are not affiliated with or endorsed by
+ *    Hobbytronics in any way.
+ *
+ * Product website: http://www.hobbytronics.co.uk/tft-serial-display-18
+ * Display firmware: https://github.com/hobbytronics/serial_tft_18
+ *
+ * Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+ * License: GNU GPL v3
+ */
+
+#ifndef Arduino_HSTStripChart_h
+#define Arduino_HSTStripChart_h
+
+#include "HobbytronicsSerialTFT.h"
+
+// Enumeration of ways a strip chart can reduce several samples into one column.
+// This only matters if more than one sample is stored per column.
+enum class HSTChartStyle : uint8_t
+{
+    Decimate,   // Plot only the last sample of each column, joined to the previous column by a line.
+    Envelope    // Plot the minimum to maximum range of all samples in each column.
+};
+
+
+// This class draws a strip chart (a.k.a. trend graph) in a rectangular area of the display.
+// The display firmware can't scroll, so the chart uses a sweep-style update instead.
+// Each new column is drawn at a cursor which moves from left to right, wrapping back
+//  to the left edge when it reaches the right. The column just ahead of the cursor is
+//  erased as it goes, so there is always a visible gap between new and old data.
+// This means each column costs the same small number of commands to draw, no matter
+//  how wide the chart is.
+// A circular buffer of column data is kept so the chart can be redrawn if necessary.
+// It uses 2 bytes of RAM per column, allocated at construction.
+class HSTStripChart
+{
+public:
+    //------------------------------------------------------------------------------
+    // Construction / destruction.
+
+    // Initialise the chart to draw on the given display.
+    // x,y is the top-left corner of the chart, and width/height is its size in pixels.
+    // minValue/maxValue specify the range of sample values which will fit in the chart.
+    // Samples outside that range will be clamped to the edge of the chart.
+    // This doesn't draw anything. Call clear() to prepare the chart area first.
+    // WARNING: It is essential that the provided tft object exists for as long
+    //    as this object is trying to draw on it. You must manage this yourself.
+    HSTStripChart(HobbytronicsSerialTFT &tft, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int minValue, int maxValue);
+
+    // Destructor.
+    ~HSTStripChart();
+
+
+    //------------------------------------------------------------------------------
+    // Disallowed operations.
+
+    // Default construction is not allowed.
+    HSTStripChart() = delete;
+
+    // Copy construction is not permitted.
+    HSTStripChart(const HSTStripChart &) = delete;
+
+    // Copy assignment is not permitted.
+    void operator = (const HSTStripChart &) = delete;
+
+
+    //------------------------------------------------------------------------------
+    // Settings.
+
+    /// Set the colour which will be used to draw the trace.
+    /// Default is green.
+    void setTraceColour(const HSTColour col) { m_colTrace = col; }
+
+    /// Same as setTraceColour(), but with American spelling.
+    void setTraceColor(const HSTColor col) { setTraceColour(col); }
+
+    /// Set the colour which will be used for the chart background.
+    /// Default is black.
+    void setBackgroundColour(const HSTColour col) { m_colBackground = col; }
+
+    /// Same as setBackgroundColour(), but with American spelling.
+    void setBackgroundColor(const HSTColor col) { setBackgroundColour(col); }
+
+    /// Set how many samples are combined into each column of the chart.
+    /// Use this when samples arrive faster than you want the chart to move.
+    /// Default is 1. Values of 0 are treated as 1.
+    /// Example usage: setSamplesPerColumn(4)
+    void setSamplesPerColumn(uint8_t samples);
+
+    /// Set how samples are combined if there is more than one per column.
+    /// This should be set before any samples are added.
+    /// Example usage: setStyle(HSTChartStyle::Envelope)
+    void setStyle(const HSTChartStyle style) { m_style = style; }
+
+
+    //------------------------------------------------------------------------------
+    // Drawing.
+
+    /// Erase the chart area and discard all stored samples.
+    /// The next sample will be drawn at the left edge of the chart.
+    void clear();
+
+    /// Erase the chart area and draw it again from the stored samples.
+    /// This is only needed if something else has drawn over the chart, e.g. clearScreen().
+    void redraw();
+
+    /// Add a sample to the chart.
+    /// The chart moves along by one column each time the number of samples specified
+    ///  by setSamplesPerColumn() has been added.
+    /// Example usage: addSample(analogRead(A0))
+    void addSample(int value);
+
+
+private:
+    //------------------------------------------------------------------------------
+    // Internal operations.
+
+    // Convert a sample value to a y pixel position on the display.
+    uint8_t valueToY(int value) const;
+
+    // Store the pending samples in the column at the cursor, and draw it.
+    // This also erases the column ahead of the cursor, and moves the cursor on.
+    void commitColumn();
+
+    // Erase the whole chart area, using the background colour.
+    void eraseChart();
+
+    // Erase the specified column of the chart, using the background colour.
+    // This assumes the display's line colour has already been set.
+    void eraseColumn(uint8_t col);
+
+    // Draw the specified column of the chart from the stored data, using the trace colour.
+    // If connect is true then it will be joined up to the previous column.
+    // This assumes the display's line colour has already been set.
+    void drawColumn(uint8_t col, bool connect);
+
+    // Check if the specified column is joined to the previous one when it is drawn.
+    bool isJoined(uint8_t col) const;
+
+
+    //------------------------------------------------------------------------------
+    // Data.
+
+    // The display we are drawing on.
+    HobbytronicsSerialTFT & m_tft;
+
+    // Position of the top-left corner of the chart, in pixels.
+    uint8_t m_x;
+    uint8_t m_y;
+
+    // Size of the chart, in pixels.
+    uint8_t m_width;
+    uint8_t m_height;
+
+    // Range of sample values which can be shown in the chart.
+    int m_minValue;
+    int m_maxValue;
+
+    // The colour used to draw the trace.
+    HSTColour m_colTrace;
+
+    // The colour used to erase the chart.
+    HSTColour m_colBackground;
+
+    // How samples are combined if there is more than one per column.
+    HSTChartStyle m_style;
+
+    // How many samples are combined into each column.
+    uint8_t m_samplesPerColumn;
+
+    // How many samples have been added to the column at the cursor so far.
+    uint8_t m_pendingCount;
+
+    // The highest and lowest y pixel positions of samples added to the pending column.
+    // For the Decimate style, both contain the most recent sample.
+    uint8_t m_pendingTop;
+    uint8_t m_pendingBottom;
+
+    // The column which the next completed column will be drawn in.
+    uint8_t m_cursor;
+
+    // How many columns contain data.
+    // This stops at m_width once the cursor has swept across the whole chart.
+    uint8_t m_numColumns;
+
+    // Circular buffers containing the highest and lowest y pixel positions for each column.
+    // Each one has m_width elements.
+    uint8_t * m_colTop;
+    uint8_t * m_colBottom;
+};
+
+#endif //Arduino_HSTStripChart_h
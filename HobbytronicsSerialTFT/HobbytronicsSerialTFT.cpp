@@ -13,6 +13,7 @@
  */
 
 #include "HobbytronicsSerialTFT.h"
+#include "HSTProfiler.h"
 
 // The byte which signals the beginning of a command.
 constexpr static uint8_t g_beginCmd = 0x1B;
@@ -20,20 +21,24 @@ constexpr static uint8_t g_beginCmd = 0x1B;
 // The byte which signals the end of a command.
 constexpr static uint8_t g_endCmd = 0xFF;
 
+// A value which never matches a real colour.
+// This must fit in 4 bits, as colours are stored in bit fields in the lean profile.
+constexpr static uint8_t g_unknownCol = 0x0F;
+
 
 //------------------------------------------------------------------------------
 // Construction / destruction.
 
 HobbytronicsSerialTFT::HobbytronicsSerialTFT(HardwareSerial &hwserial) :
-    m_serialMode(SerialMode::Hardware),
     m_output(&hwserial),
     m_resetPin(0),
     m_hasResetPin(false),
-    m_lastBGCol(255),
-    m_lastFGCol(255),
-    m_colLine(HSTColour::White),
-    m_colFill(HSTColour::Blue),
-    m_colBackground(HSTColour::Black)
+    m_lastBGCol(g_unknownCol),
+    m_lastFGCol(g_unknownCol),
+    m_colLine(static_cast<uint8_t>(HSTColour::White)),
+    m_colFill(static_cast<uint8_t>(HSTColour::Blue)),
+    m_colBackground(static_cast<uint8_t>(HSTColour::Black)),
+    m_serialMode(static_cast<uint8_t>(SerialMode::Hardware))
 {
 }
 
@@ -44,15 +49,15 @@ HobbytronicsSerialTFT::HobbytronicsSerialTFT(HardwareSerial &hwserial, uint8_t r
 }
 
 HobbytronicsSerialTFT::HobbytronicsSerialTFT(SoftwareSerial &swserial) :
-    m_serialMode(SerialMode::SoftwareExternal),
     m_output(&swserial),
     m_resetPin(0),
     m_hasResetPin(false),
-    m_lastBGCol(255),
-    m_lastFGCol(255),
-    m_colLine(HSTColour::White),
-    m_colFill(HSTColour::Blue),
-    m_colBackground(HSTColour::Black)
+    m_lastBGCol(g_unknownCol),
+    m_lastFGCol(g_unknownCol),
+    m_colLine(static_cast<uint8_t>(HSTColour::White)),
+    m_colFill(static_cast<uint8_t>(HSTColour::Blue)),
+    m_colBackground(static_cast<uint8_t>(HSTColour::Black)),
+    m_serialMode(static_cast<uint8_t>(SerialMode::SoftwareExternal))
 {
 }
 
@@ -63,15 +68,15 @@ HobbytronicsSerialTFT::HobbytronicsSerialTFT(SoftwareSerial &swserial, uint8_t r
 }
 
 HobbytronicsSerialTFT::HobbytronicsSerialTFT(uint8_t rx, uint8_t tx) :
-    m_serialMode(SerialMode::SoftwareInternal),
     m_output(new SoftwareSerial(rx, tx)),
     m_resetPin(0),
     m_hasResetPin(false),
-    m_lastBGCol(255),
-    m_lastFGCol(255),
-    m_colLine(HSTColour::White),
-    m_colFill(HSTColour::Blue),
-    m_colBackground(HSTColour::Black)
+    m_lastBGCol(g_unknownCol),
+    m_lastFGCol(g_unknownCol),
+    m_colLine(static_cast<uint8_t>(HSTColour::White)),
+    m_colFill(static_cast<uint8_t>(HSTColour::Blue)),
+    m_colBackground(static_cast<uint8_t>(HSTColour::Black)),
+    m_serialMode(static_cast<uint8_t>(SerialMode::SoftwareInternal))
 {
 }
 
@@ -81,10 +86,29 @@ HobbytronicsSerialTFT::HobbytronicsSerialTFT(uint8_t rx, uint8_t tx, uint8_t res
     setupReset(resetPin);
 }
 
+HobbytronicsSerialTFT::HobbytronicsSerialTFT(Stream &stream) :
+    m_output(&stream),
+    m_resetPin(0),
+    m_hasResetPin(false),
+    m_lastBGCol(g_unknownCol),
+    m_lastFGCol(g_unknownCol),
+    m_colLine(static_cast<uint8_t>(HSTColour::White)),
+    m_colFill(static_cast<uint8_t>(HSTColour::Blue)),
+    m_colBackground(static_cast<uint8_t>(HSTColour::Black)),
+    m_serialMode(static_cast<uint8_t>(SerialMode::StreamExternal))
+{
+}
+
+HobbytronicsSerialTFT::HobbytronicsSerialTFT(Stream &stream, uint8_t resetPin) :
+    HobbytronicsSerialTFT(stream)
+{
+    setupReset(resetPin);
+}
+
 HobbytronicsSerialTFT::~HobbytronicsSerialTFT()
 {
     // Important: Destroy the software serial object we created, if applicable.
-    if (m_serialMode == SerialMode::SoftwareInternal) {
+    if (static_cast<SerialMode>(m_serialMode) == SerialMode::SoftwareInternal) {
         delete static_cast<SoftwareSerial*>(m_output);
     }
     m_output = nullptr;
@@ -105,7 +129,7 @@ void HobbytronicsSerialTFT::reset()
 
 void HobbytronicsSerialTFT::begin(unsigned long speed)
 {
-    switch (m_serialMode)
+    switch (static_cast<SerialMode>(m_serialMode))
     {
     case SerialMode::Hardware:
         static_cast<HardwareSerial*>(m_output)->begin(speed);
@@ -117,11 +141,16 @@ void HobbytronicsSerialTFT::begin(unsigned long speed)
         //    of an unsigned long.
         static_cast<SoftwareSerial*>(m_output)->begin(static_cast<long>(speed));
         break;
+
+    case SerialMode::StreamExternal:
+        // We don't know how to open a generic stream.
+        break;
     }
 }
 
 void HobbytronicsSerialTFT::flush()
 {
+    HST_PROFILE(Flush);
     m_output->flush();
 }
 
@@ -130,17 +159,17 @@ void HobbytronicsSerialTFT::flush()
 
 void HobbytronicsSerialTFT::setBackgroundColour(const HSTColour col)
 {
-    m_colBackground = col;
+    m_colBackground = static_cast<uint8_t>(col);
 }
 
 void HobbytronicsSerialTFT::setLineColour(const HSTColour col)
 {
-    m_colLine = col;
+    m_colLine = static_cast<uint8_t>(col);
 }
 
 void HobbytronicsSerialTFT::setFillColour(const HSTColour col)
 {
-    m_colFill = col;
+    m_colFill = static_cast<uint8_t>(col);
 }
 
 
@@ -159,7 +188,8 @@ void HobbytronicsSerialTFT::setBacklightBrightness(uint8_t level)
 
 void HobbytronicsSerialTFT::clearScreen()
 {
-    
+    HST_PROFILE(ClearScreen);
+    applyBackgroundColour();
     sendCommand(0);
 }
 
@@ -215,6 +245,7 @@ void HobbytronicsSerialTFT::drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t
 
 void HobbytronicsSerialTFT::drawBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, HSTShapeStyle style)
 {
+    HST_PROFILE(DrawBox);
     if (style == HSTShapeStyle::Fill || style == HSTShapeStyle::FilledOutline) {
         applyFillColour();
         sendCommand(10, x1, y1, x2, y2);
@@ -228,6 +259,7 @@ void HobbytronicsSerialTFT::drawBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t
 
 void HobbytronicsSerialTFT::drawCircle(uint8_t x, uint8_t y, uint8_t radius, HSTShapeStyle style)
 {
+    HST_PROFILE(DrawCircle);
     if (style == HSTShapeStyle::Fill || style == HSTShapeStyle::FilledOutline) {
         applyFillColour();
         sendCommand(12, x, y, radius);
@@ -270,8 +302,18 @@ void HobbytronicsSerialTFT::gotoPixelPosition(uint8_t x, uint8_t y)
 
 size_t HobbytronicsSerialTFT::write(uint8_t data)
 {
+    HST_PROFILE(Write);
+    applyLineColour();
+    applyBackgroundColour();
+    return m_output->write(data);
+}
+
+size_t HobbytronicsSerialTFT::write(const uint8_t *buffer, size_t size)
+{
+    HST_PROFILE(Write);
     applyLineColour();
-    m_output->write(data);
+    applyBackgroundColour();
+    return m_output->write(buffer, size);
 }
 
 
@@ -350,16 +392,16 @@ void HobbytronicsSerialTFT::sendForegroundColour(HSTColour col)
 
 void HobbytronicsSerialTFT::applyBackgroundColour()
 {
-    sendBackgroundColour(m_colBackground);
+    sendBackgroundColour(getBackgroundColour());
 }
 
 void HobbytronicsSerialTFT::applyLineColour()
 {
-    sendForegroundColour(m_colLine);
+    sendForegroundColour(getLineColour());
 }
 
 void HobbytronicsSerialTFT::applyFillColour()
 {
-    sendForegroundColour(m_colFill);
+    sendForegroundColour(getFillColour());
 }
 
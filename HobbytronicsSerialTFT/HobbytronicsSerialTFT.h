@@ -17,6 +17,7 @@
 
 #include "Arduino.h"
 #include <SoftwareSerial.h>
+#include "HSTConfig.h"
 
 // Enumeration of colours supported by the Hobbytronics Serial TFT display.
 enum class HSTColour : uint8_t
@@ -62,6 +63,8 @@ enum class HSTShapeStyle : uint8_t
 };
 
 
+inline namespace HST_LAYOUT_NAMESPACE {
+
 // This class constructs and sends commands to control the Hobbytronics Serial TFT 1.8 inch display.
 // Note that this derives from Print, so text can be sent to the display using the usual text
 //    printing member functions, such as print("foo").
@@ -125,6 +128,26 @@ public:
     // If you want to reset it again later, call reset() after construction.
     HobbytronicsSerialTFT(uint8_t rx, uint8_t tx, uint8_t resetPin);
 
+    // Initialise this object to send everything to the given Stream object.
+    // This is intended for wrappers around a real serial port, such as HSTCaptureStream.
+    // The begin() function on this class does nothing in this case. You need to open
+    //    the underlying serial connection yourself.
+    // This does not specify a reset pin. It assumes you will handle that yourself.
+    // WARNING: It is essential that the provided stream object exists for as long
+    //    as this object is trying to talk to it. You must manage this yourself.
+    HobbytronicsSerialTFT(Stream &stream);
+
+    // Initialise this object to send everything to the given Stream object.
+    // This is intended for wrappers around a real serial port, such as HSTCaptureStream.
+    // The begin() function on this class does nothing in this case. You need to open
+    //    the underlying serial connection yourself.
+    // resetPin specifies which pin is connected to the display's reset line.
+    // This will ensure the reset pin is held high, but it will not actually cause
+    //  a reset unless you call reset().
+    // WARNING: It is essential that the provided stream object exists for as long
+    //    as this object is trying to talk to it. You must manage this yourself.
+    HobbytronicsSerialTFT(Stream &stream, uint8_t resetPin);
+
     // Destructor.
     ~HobbytronicsSerialTFT();
 
@@ -158,6 +181,7 @@ public:
     // If you provided an external HardwareSerial or SoftwareSerial object in the
     //    constructor then this may not be necessary. You can open the serial
     //    using the original object directly instead.
+    // If you provided some other kind of Stream object then this does nothing.
     // However, if you only provided pin numbers in the constructor then you must
     //    call this before you can communicate with the display.
     void begin(unsigned long speed = 9600);
@@ -195,6 +219,25 @@ public:
     void setFillColor(const HSTColor col) { setFillColour(col); }
     
     
+    /// Get the background colour which is currently used for drawing.
+    HSTColour getBackgroundColour() const { return static_cast<HSTColour>(m_colBackground); }
+    
+    /// Same as getBackgroundColour(), but with American spelling.
+    HSTColor getBackgroundColor() const { return getBackgroundColour(); }
+    
+    /// Get the colour which is currently used for line drawing and text.
+    HSTColour getLineColour() const { return static_cast<HSTColour>(m_colLine); }
+    
+    /// Same as getLineColour(), but with American spelling.
+    HSTColor getLineColor() const { return getLineColour(); }
+    
+    /// Get the colour which is currently used for filling shapes.
+    HSTColour getFillColour() const { return static_cast<HSTColour>(m_colFill); }
+    
+    /// Same as getFillColour(), but with American spelling.
+    HSTColor getFillColor() const { return getFillColour(); }
+    
+    
     //------------------------------------------------------------------------------
     // General display functions.
     
@@ -285,6 +328,14 @@ public:
     //  Print class to draw strings and numbers.
     size_t write(uint8_t) override;
 
+    // Write several characters to the display.
+    // This is used by print() and println() for strings, so the colours only need
+    //  to be checked once per string rather than once per character.
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    // Make the other write() overloads from Print visible, e.g. write("foo").
+    using Print::write;
+
 
 private:
     //------------------------------------------------------------------------------
@@ -334,26 +385,21 @@ private:
     // Internal declarations.
     
     // Enumeration of the serial modes we can have.
-    enum class SerialMode
+    enum class SerialMode : uint8_t
     {
             Hardware,                 // Using Hardware Serial. The object is always provided externally in this case.
             SoftwareExternal, // Using Software Serial. The object was provided externally.
-            SoftwareInternal    // Using Software Serial. The object was created and is owned by this class.
+            SoftwareInternal,   // Using Software Serial. The object was created and is owned by this class.
+            StreamExternal      // Using some other kind of Stream. The object was provided externally.
     };
     
     
     //------------------------------------------------------------------------------
     // Data.
     
-    // Specifies what kind of serial object is stored in m_output.
-    // This also indicates whether or not we own the object.
-    // If this is SoftwareInternal then we need to delete the target m_output when
-    //    this object is destroyed.
-    SerialMode m_serialMode;
-    
     // Pointer to the object we're sending serial commands/data to.
-    // This could be pointing to a HardwareSerial or SoftwareSerial object provided
-    //    externally, or it could simply be a copy of m_internalSerial.
+    // This could be pointing to a HardwareSerial, SoftwareSerial, or other Stream object
+    //    provided externally, or it could simply be a copy of m_internalSerial.
     // The actual type can be inferred from m_serialMode.
     // We assume that it is always valid after construction of this object.
     Stream * m_output;
@@ -361,35 +407,47 @@ private:
     // The reset pin, if one was provided at construction.
     uint8_t m_resetPin;
 
+    
+    // The fields below are packed into bit fields if HST_LEAN is enabled in HSTConfig.h.
+    // Colours and the serial mode are stored as numeric values so that they fit.
+    
     // Indicates if a reset pin was provided at construction.
-    bool m_hasResetPin;
+    bool m_hasResetPin HST_BITS(1);
     
     
     // The background colour value most recently sent to the display.
     // This is used to avoid sending it more often than necessary.
     // It is initially set to an invalid colour value so that the first
     //  colour used is always sent.
-    uint8_t m_lastBGCol;
+    uint8_t m_lastBGCol HST_BITS(4);
     
     // The foreground colour value most recently sent to the display.
     // This is used to avoid sending it more often than necessary.
     // It is initially set to an invalid colour value so that the first
     //  colour used is always sent.
-    uint8_t m_lastFGCol;
+    uint8_t m_lastFGCol HST_BITS(4);
     
     
     // The current colour for drawing lines and text.
     // Default is white.
-    HSTColour m_colLine;
+    uint8_t m_colLine HST_BITS(3);
     
     // The current colour for filling shapes.
     // Default is blue.
-    HSTColour m_colFill;
+    uint8_t m_colFill HST_BITS(3);
     
     // The current colour for clearing the screen and for text background.
     // Default is black;
-    HSTColour m_colBackground;
+    uint8_t m_colBackground HST_BITS(3);
+    
+    // Specifies what kind of serial object is stored in m_output.
+    // This also indicates whether or not we own the object.
+    // If this is SoftwareInternal then we need to delete the target m_output when
+    //    this object is destroyed.
+    uint8_t m_serialMode HST_BITS(2);
 };
 
+} //inline namespace HST_LAYOUT_NAMESPACE
+
 #endif //Arduino_HobbytronicsSerialTFT_h
 
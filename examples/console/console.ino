@@ -0,0 +1,63 @@
+/*
+ * Console demo for Arduino HobbytronicsSerialTFT library.
+ * Example of using the display as a scrolling log console, printing
+ *  the uptime and the reading from analog pin A0 once per second.
+ *
+ * License: GNU GPL v3
+ * Author: Peter R. Bloomfield
+ * Web: http://avidinsight.uk
+ *
+ * See the accompanying README for further information, including setup instructions.
+ */
+
+#include <HobbytronicsSerialTFT.h>
+#include <HSTConsole.h>
+
+// Specify which pins are connected to which point on the display board.
+const int tft_reset = 5;
+const int tft_tx = 6;
+const int tft_rx = 7;
+
+// Construct our serial TFT object.
+// It will construct its own SoftwareSerial object internally.
+HobbytronicsSerialTFT tft(tft_tx, tft_rx, tft_reset);
+
+// Construct a console covering the whole screen, using the small font in landscape.
+// That gives 26x16 character cells.
+HSTConsole console(tft, HSTFontSize::Small, HSTRotation::Landscape);
+
+void setup()
+{
+  // Open the serial connection to the display.
+  tft.begin();
+
+  // The display seems to need as much as 4 seconds to be fully online
+  //  and ready to receive commands.
+  delay(4000);
+
+  // This sets the font size and screen rotation, and clears the screen.
+  console.begin();
+  console.setTextColour(HSTColour::Cyan);
+  console.println("Console demo");
+  console.setTextColour(HSTColour::White);
+  tft.flush();
+}
+
+void loop()
+{
+  const int value = analogRead(A0);
+
+  // Once the screen is full, each new line scrolls the console up.
+  // Only the characters which are different from the line above are redrawn.
+  console.print("t=");
+  console.print(millis() / 1000);
+  console.print("s A0=");
+  if (value > 900) {
+    console.setTextColour(HSTColour::Red);
+  }
+  console.println(value);
+  console.setTextColour(HSTColour::White);
+  tft.flush();
+
+  delay(1000);
+}
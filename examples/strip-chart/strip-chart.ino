@@ -0,0 +1,75 @@
+/*
+ * Strip chart demo for Arduino HobbytronicsSerialTFT library.
+ * Example of a sweeping trend graph showing the voltage on analog pin A0,
+ *  with a second chart showing the min/max envelope of the same signal.
+ *
+ * License: GNU GPL v3
+ * Author: Peter R. Bloomfield
+ * Web: http://avidinsight.uk
+ *
+ * See the accompanying README for further information, including setup instructions.
+ */
+
+#include <HobbytronicsSerialTFT.h>
+#include <HSTStripChart.h>
+
+// Specify which pins are connected to which point on the display board.
+const int tft_reset = 5;
+const int tft_tx = 6;
+const int tft_rx = 7;
+
+// Construct our serial TFT object.
+// It will construct its own SoftwareSerial object internally.
+HobbytronicsSerialTFT tft(tft_tx, tft_rx, tft_reset);
+
+// The top chart plots every sample.
+// It covers most of the screen width, and the full range of analogRead().
+HSTStripChart liveChart(tft, 4, 16, 152, 48, 0, 1023);
+
+// The bottom chart combines 8 samples into each column, showing their min/max range.
+HSTStripChart envelopeChart(tft, 4, 76, 152, 48, 0, 1023);
+
+void setup()
+{
+  // Open the serial connection to the display.
+  tft.begin();
+
+  // The display seems to need as much as 4 seconds to be fully online
+  //  and ready to receive commands.
+  delay(4000);
+
+  // General setup.
+  tft.setBackgroundColour(HSTColour::Black);
+  tft.setScreenRotation(HSTRotation::Landscape);
+  tft.setFontSize(HSTFontSize::Small);
+  tft.flush();
+  tft.clearScreen();
+
+  // Label the charts.
+  tft.setLineColour(HSTColour::White);
+  tft.gotoPixelPosition(4, 4);
+  tft.print("A0 live");
+  tft.gotoPixelPosition(4, 66);
+  tft.print("A0 envelope x8");
+
+  liveChart.setTraceColour(HSTColour::Green);
+  liveChart.clear();
+
+  envelopeChart.setTraceColour(HSTColour::Yellow);
+  envelopeChart.setStyle(HSTChartStyle::Envelope);
+  envelopeChart.setSamplesPerColumn(8);
+  envelopeChart.clear();
+  tft.flush();
+}
+
+void loop()
+{
+  // Each sample only sends a couple of short commands to the display,
+  //  no matter how much data is already on the charts.
+  const int value = analogRead(A0);
+  liveChart.addSample(value);
+  envelopeChart.addSample(value);
+  tft.flush();
+
+  delay(20);
+}
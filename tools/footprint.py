@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+footprint.py
+Reports the flash and RAM cost of each HobbytronicsSerialTFT feature, in each build profile.
+
+It compiles tools/footprint/footprint.ino with arduino-cli for each combination of build
+profile (default or lean) and feature, then reads the resulting ELF file to find:
+  - flash: bytes of .text and .data
+  - ram:   bytes of .data and .bss (static RAM only, not heap or stack)
+  - the sizeof() of each library object, from its size in the symbol table
+Each feature is reported as the difference from the base build in the same profile.
+
+NOTE: This library and the author are not affiliated with or endorsed by
+   Hobbytronics in any way.
+
+Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+License: GNU GPL v3
+
+Example usage:
+    python3 footprint.py
+    python3 footprint.py --fqbn arduino:avr:nano --flags "-DHST_CAPTURE_BUFFER_SIZE=16"
+
+Requires arduino-cli, with the core for the chosen board installed.
+"""
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.join(TOOLS_DIR, "footprint")
+LIBRARY_DIR = os.path.join(os.path.dirname(TOOLS_DIR), "HobbytronicsSerialTFT")
+
+# Build profile name -> compiler flags.
+PROFILES = [
+    ("default", []),
+    ("lean", ["-DHST_LEAN=1"]),
+]
+
+# Feature name -> compiler flags. The first entry is the base which the others are compared to.
+FEATURES = [
+    ("base", []),
+    ("chart", ["-DHST_FOOTPRINT_CHART=1"]),
+    ("console", ["-DHST_FOOTPRINT_CONSOLE=1"]),
+    ("capture", ["-DHST_FOOTPRINT_CAPTURE=1"]),
+    ("profiler", ["-DHST_PROFILING=1"]),
+]
+
+# Global objects in the footprint sketch -> the class they are an instance of.
+OBJECTS = [
+    ("g_tft", "HobbytronicsSerialTFT"),
+    ("g_chart", "HSTStripChart"),
+    ("g_console", "HSTConsole"),
+    ("g_capture", "HSTCaptureStream"),
+]
+
+
+def find_tool(name, prefix):
+    """Find a toolchain program on the PATH, or in the Arduino tools directories."""
+    path = shutil.which(prefix + name)
+    if path:
+        return path
+    patterns = [
+        os.path.expanduser("~/.arduino15/packages/*/tools/*/*/bin/" + prefix + name),
+        os.path.expanduser("~/Library/Arduino15/packages/*/tools/*/*/bin/" + prefix + name),
+        os.path.expanduser("~/AppData/Local/Arduino15/packages/*/tools/*/*/bin/" + prefix + name + ".exe"),
+    ]
+    for pattern in patterns:
+        matches = sorted(glob.glob(pattern))
+        if matches:
+            return matches[-1]
+    raise RuntimeError("couldn't find %s%s. Use --toolchain-prefix to specify it." % (prefix, name))
+
+
+def compile_sketch(args, flags, out_dir):
+    """Compile the footprint sketch with the given flags. Returns the path to the ELF file."""
+    cmd = [
+        args.arduino_cli, "compile",
+        "--fqbn", args.fqbn,
+        "--library", LIBRARY_DIR,
+        "--build-property", "compiler.cpp.extra_flags=" + " ".join(flags),
+        "--output-dir", out_dir,
+        SKETCH_DIR,
+    ]
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        raise RuntimeError("compile failed with flags %s:\n%s" % (" ".join(flags), result.stdout))
+    elfs = glob.glob(os.path.join(out_dir, "*.elf"))
+    if not elfs:
+        raise RuntimeError("no ELF file was produced in %s" % out_dir)
+    return elfs[0]
+
+
+def section_sizes(size_tool, elf):
+    """Returns (flash, ram) in bytes for an ELF file."""
+    out = subprocess.check_output([size_tool, "-A", elf], universal_newlines=True)
+    sections = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sections[parts[0]] = int(parts[1])
+    text = sections.get(".text", 0)
+    data = sections.get(".data", 0)
+    bss = sections.get(".bss", 0)
+    return text + data, data + bss
+
+
+def object_sizes(nm_tool, elf):
+    """Returns a dict of global object name -> size in bytes, for the objects in OBJECTS."""
+    out = subprocess.check_output([nm_tool, "-S", "-C", elf], universal_newlines=True)
+    names = set(name for name, _ in OBJECTS)
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[3] in names:
+            sizes[parts[3]] = int(parts[1], 16)
+    return sizes
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the footprint of HobbytronicsSerialTFT features.")
+    parser.add_argument("--fqbn", default="arduino:avr:uno", help="board to compile for")
+    parser.add_argument("--arduino-cli", default="arduino-cli", help="path to arduino-cli")
+    parser.add_argument("--toolchain-prefix", default="avr-", help="prefix for the size and nm programs")
+    parser.add_argument("--flags", default="", help="extra compiler flags for every build, e.g. size options")
+    args = parser.parse_args()
+
+    try:
+        size_tool = find_tool("size", args.toolchain_prefix)
+        nm_tool = find_tool("nm", args.toolchain_prefix)
+        extra = args.flags.split()
+
+        results = []
+        sizeofs = {}
+        with tempfile.TemporaryDirectory() as tmp:
+            for profile, profile_flags in PROFILES:
+                for feature, feature_flags in FEATURES:
+                    out_dir = os.path.join(tmp, profile + "-" + feature)
+                    print("compiling %s/%s..." % (profile, feature), file=sys.stderr)
+                    elf = compile_sketch(args, profile_flags + feature_flags + extra, out_dir)
+                    flash, ram = section_sizes(size_tool, elf)
+                    results.append((profile, feature, flash, ram))
+                    for name, size in object_sizes(nm_tool, elf).items():
+                        sizeofs.setdefault(profile, {})[name] = size
+    except (RuntimeError, OSError, subprocess.CalledProcessError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    print("Board: %s   Extra flags: %s" % (args.fqbn, args.flags or "(none)"))
+    print()
+    print("%-8s  %-9s  %6s  %7s  %5s  %6s" % ("profile", "feature", "flash", "+flash", "ram", "+ram"))
+    base = {}
+    for profile, feature, flash, ram in results:
+        if feature == FEATURES[0][0]:
+            base[profile] = (flash, ram)
+            print("%-8s  %-9s  %6d  %7s  %5d  %6s" % (profile, feature, flash, "", ram, ""))
+        else:
+            print("%-8s  %-9s  %6d  %+7d  %5d  %+6d" % (
+                profile, feature, flash, flash - base[profile][0], ram, ram - base[profile][1]))
+
+    print()
+    print("%-22s  %s" % ("sizeof", "  ".join("%8s" % p for p, _ in PROFILES)))
+    for name, cls in OBJECTS:
+        row = []
+        for profile, _ in PROFILES:
+            size = sizeofs.get(profile, {}).get(name)
+            row.append("%8s" % (size if size is not None else "-"))
+        print("%-22s  %s" % (cls, "  ".join(row)))
+
+    print()
+    print("ram only counts static data. At run time these also allocate from the heap:")
+    print("  HSTStripChart: 2 bytes per column (200 bytes in this sketch)")
+    print("  HSTConsole:    2 bytes per character cell, or 1 if HST_CONSOLE_COLOURS is 0")
+    print("                 (832 or 416 bytes in this sketch)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,94 @@
+/*
+ * Footprint sketch for Arduino HobbytronicsSerialTFT library.
+ * This is compiled by tools/footprint.py with different combinations of the
+ *  HST_FOOTPRINT_* macros below, to measure what each library feature costs.
+ * It isn't meant to be uploaded.
+ *
+ * License: GNU GPL v3
+ * Author: Peter R. Bloomfield
+ * Web: http://avidinsight.uk
+ */
+
+#include <HobbytronicsSerialTFT.h>
+
+#if HST_FOOTPRINT_CHART
+#include <HSTStripChart.h>
+#endif
+
+#if HST_FOOTPRINT_CONSOLE
+#include <HSTConsole.h>
+#endif
+
+#if HST_FOOTPRINT_CAPTURE
+#include <HSTCaptureStream.h>
+#endif
+
+#if HST_PROFILING
+#include <HSTProfiler.h>
+#endif
+
+// The objects are global so that the footprint tool can find their sizes in the symbol table.
+// Hardware serial is used so that SoftwareSerial doesn't hide the cost of the library.
+#if HST_FOOTPRINT_CAPTURE
+HSTCaptureStream g_capture(Serial, Serial);
+HobbytronicsSerialTFT g_tft(g_capture);
+#else
+HobbytronicsSerialTFT g_tft(Serial);
+#endif
+
+#if HST_FOOTPRINT_CHART
+HSTStripChart g_chart(g_tft, 0, 0, 100, 64, 0, 1023);
+#endif
+
+#if HST_FOOTPRINT_CONSOLE
+HSTConsole g_console(g_tft, HSTFontSize::Small, HSTRotation::Landscape);
+#endif
+
+void setup()
+{
+  g_tft.begin();
+#if HST_FOOTPRINT_CAPTURE
+  g_capture.begin();
+#endif
+
+  // Use the same basic drawing calls in every configuration.
+  g_tft.setScreenRotation(HSTRotation::Landscape);
+  g_tft.clearScreen();
+  g_tft.setFillColour(HSTColour::Green);
+  g_tft.drawBox(10, 10, 50, 50, HSTShapeStyle::FilledOutline);
+  g_tft.drawCircle(80, 60, 20, HSTShapeStyle::Outline);
+  g_tft.drawLine(0, 0, 159, 127);
+  g_tft.gotoCharacterPosition(1, 1);
+  g_tft.print("footprint");
+  g_tft.flush();
+
+#if HST_FOOTPRINT_CHART
+  g_chart.setStyle(HSTChartStyle::Envelope);
+  g_chart.clear();
+#endif
+
+#if HST_FOOTPRINT_CONSOLE
+  g_console.begin();
+#endif
+}
+
+void loop()
+{
+#if HST_FOOTPRINT_CHART
+  g_chart.addSample(analogRead(A0));
+#endif
+
+#if HST_FOOTPRINT_CONSOLE
+  g_console.println(analogRead(A0));
+#endif
+
+#if HST_FOOTPRINT_CAPTURE
+  g_capture.markFrame();
+#endif
+
+#if HST_PROFILING
+  HSTProfiler::dump(Serial);
+#endif
+
+  g_tft.flush();
+}
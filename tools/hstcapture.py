@@ -0,0 +1,685 @@
+#!/usr/bin/env python3
+"""
+hstcapture.py
+Offline decoder for logs recorded by HSTCaptureStream in the HobbytronicsSerialTFT library.
+
+It can print a readable trace of every command sent to the display, print per-frame
+statistics (including commands which had no visible effect), and render each frame to
+a PNG image using a reference rasteriser for the display's protocol.
+
+NOTE: This library and the author are not affiliated with or endorsed by
+   Hobbytronics in any way.
+
+Library author: Peter R. Bloomfield ( http://peter.avidinsight.uk )
+License: GNU GPL v3
+
+Example usage:
+    python3 hstcapture.py trace capture.bin
+    python3 hstcapture.py stats capture.bin --baud 9600
+    python3 hstcapture.py render capture.bin --out frames/
+
+Only the Python 3 standard library is required.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+
+#------------------------------------------------------------------------------
+# Log format. This must match HSTCaptureStream.cpp.
+
+LOG_MAGIC = b"HSTC"
+LOG_VERSION = 1
+
+RECORD_DATA = 1
+RECORD_FLUSH = 2
+RECORD_FRAME = 3
+
+
+#------------------------------------------------------------------------------
+# Display protocol. This must match HobbytronicsSerialTFT.cpp.
+
+BEGIN_CMD = 0x1B
+END_CMD = 0xFF
+
+# Opcode -> (name, number of fixed parameter bytes).
+# The bitmap command is followed by a filename of variable length.
+OPCODES = {
+    0: ("clearScreen", 0),
+    1: ("foregroundColour", 1),
+    2: ("backgroundColour", 1),
+    3: ("screenRotation", 1),
+    4: ("fontSize", 1),
+    5: ("gotoTextLineStart", 0),
+    6: ("gotoCharacterPosition", 2),
+    7: ("gotoPixelPosition", 2),
+    8: ("drawLine", 4),
+    9: ("drawBox", 4),
+    10: ("drawFilledBox", 4),
+    11: ("drawCircle", 3),
+    12: ("drawFilledCircle", 3),
+    13: ("drawBitmap", 2),
+    14: ("backlightBrightness", 1),
+}
+
+# Opcodes which put something on the screen.
+DRAW_OPCODES = (0, 8, 9, 10, 11, 12, 13)
+
+COLOUR_NAMES = ["Black", "Blue", "Red", "Green", "Cyan", "Magenta", "Yellow", "White"]
+
+COLOUR_RGB = [
+    (0, 0, 0),
+    (0, 0, 255),
+    (255, 0, 0),
+    (0, 255, 0),
+    (0, 255, 255),
+    (255, 0, 255),
+    (255, 255, 0),
+    (255, 255, 255),
+]
+
+ROTATION_NAMES = ["PortraitInverted", "LandscapeInverted", "Portrait", "Landscape"]
+
+FONT_NAMES = {1: "Small", 2: "Medium", 3: "Large"}
+
+# The panel is stored in landscape orientation, whatever the current rotation is.
+PANEL_WIDTH = 160
+PANEL_HEIGHT = 128
+
+# Size of a character cell in pixels, at font size 1. Larger fonts scale this up.
+CHAR_WIDTH = 6
+CHAR_HEIGHT = 8
+
+
+#------------------------------------------------------------------------------
+# Log decoding.
+
+class Record:
+    """One record from the capture log. Times are in microseconds since begin()."""
+
+    def __init__(self, kind, time, data=b"", duration=0):
+        self.kind = kind
+        self.time = time
+        self.data = data
+        self.duration = duration
+
+
+class Command:
+    """One command (or run of text) decoded from the data sent to the display."""
+
+    def __init__(self, time, opcode, params=(), text=b"", filename=""):
+        # opcode is None for text.
+        self.time = time
+        self.opcode = opcode
+        self.params = tuple(params)
+        self.text = text
+        self.filename = filename
+        self.size = 0
+
+    def name(self):
+        if self.opcode is None:
+            return "text"
+        if self.opcode in OPCODES:
+            return OPCODES[self.opcode][0]
+        return "unknown(%d)" % self.opcode
+
+    def describe(self):
+        if self.opcode is None:
+            return 'text %r' % self.text.decode("latin-1")
+        name = self.name()
+        p = self.params
+        if self.opcode in (1, 2) and p[0] < len(COLOUR_NAMES):
+            return "%s %s" % (name, COLOUR_NAMES[p[0]])
+        if self.opcode == 3 and p[0] < len(ROTATION_NAMES):
+            return "%s %s" % (name, ROTATION_NAMES[p[0]])
+        if self.opcode == 4 and p[0] in FONT_NAMES:
+            return "%s %s" % (name, FONT_NAMES[p[0]])
+        if self.opcode == 13:
+            return "%s %d,%d %r" % (name, p[0], p[1], self.filename)
+        if self.opcode in (8, 9, 10):
+            return "%s %d,%d -> %d,%d" % ((name,) + p)
+        if self.opcode in (11, 12):
+            return "%s centre %d,%d radius %d" % ((name,) + p)
+        if p:
+            return "%s %s" % (name, ",".join(str(v) for v in p))
+        return name
+
+
+class TruncatedLog(ValueError):
+    """Raised when a capture log ends part way through a record."""
+
+
+def read_varint(buf, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(buf):
+            raise TruncatedLog("truncated varint at offset %d" % pos)
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value, pos
+        shift += 7
+
+
+def read_records(path):
+    """Read all records from a capture log, converting time deltas to absolute times.
+    If the log was cut off part way through a record, the records before it are returned."""
+    with open(path, "rb") as f:
+        buf = f.read()
+    if len(buf) < 6 or buf[:4] != LOG_MAGIC:
+        raise ValueError("%s is not an HSTCaptureStream log" % path)
+    if buf[4] != LOG_VERSION:
+        raise ValueError("unsupported log version %d" % buf[4])
+
+    records = []
+    pos = 6
+    time = 0
+    while pos < len(buf):
+        start = pos
+        try:
+            kind = buf[pos]
+            pos += 1
+            delta, pos = read_varint(buf, pos)
+            time += delta
+            if kind == RECORD_DATA:
+                if pos >= len(buf):
+                    raise TruncatedLog("truncated record length at offset %d" % pos)
+                length = buf[pos]
+                pos += 1
+                data = buf[pos:pos + length]
+                pos += length
+                # Keep whatever part of the data made it into the log.
+                records.append(Record(kind, time, data=data))
+                if len(data) < length:
+                    raise TruncatedLog("truncated data at offset %d" % (pos - length))
+            elif kind == RECORD_FLUSH:
+                duration, pos = read_varint(buf, pos)
+                records.append(Record(kind, time, duration=duration))
+            elif kind == RECORD_FRAME:
+                records.append(Record(kind, time))
+            else:
+                raise ValueError("unknown record type %d at offset %d" % (kind, start))
+        except TruncatedLog as e:
+            print("warning: log ends part way through the record at offset %d (%s)" % (start, e),
+                  file=sys.stderr)
+            break
+    return records
+
+
+def positive_int(text):
+    """Argument type for options which must be a whole number of at least 1."""
+    value = int(text)
+    if value < 1:
+        raise argparse.ArgumentTypeError("must be at least 1, not %d" % value)
+    return value
+
+
+class CommandParser:
+    """Decodes the byte stream sent to the display into commands and runs of text."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.pending_time = 0
+        self.text = bytearray()
+        self.text_time = 0
+        self.malformed = 0
+
+    def feed(self, data, time):
+        """Decode some bytes which were written at the specified time.
+        Returns a list of complete commands."""
+        out = []
+        for b in data:
+            if self.pending:
+                self.pending.append(b)
+                cmd = self._try_complete()
+                if cmd is not None:
+                    out.append(cmd)
+            elif b == BEGIN_CMD:
+                self._end_text(out)
+                self.pending = bytearray([b])
+                self.pending_time = time
+            else:
+                if not self.text:
+                    self.text_time = time
+                self.text.append(b)
+        return out
+
+    def end_text(self):
+        """Return any text which is still pending, e.g. at the end of a frame."""
+        out = []
+        self._end_text(out)
+        return out
+
+    def finish(self):
+        """Return any text which is still pending at the end of the log."""
+        out = self.end_text()
+        if self.pending:
+            self.malformed += 1
+            self.pending = bytearray()
+        return out
+
+    def _end_text(self, out):
+        if self.text:
+            cmd = Command(self.text_time, None, text=bytes(self.text))
+            cmd.size = len(self.text)
+            out.append(cmd)
+            self.text = bytearray()
+
+    def _try_complete(self):
+        p = self.pending
+        if len(p) < 2:
+            return None
+        opcode = p[1]
+        if opcode not in OPCODES:
+            # We can't know the length, so resynchronise on the next end byte.
+            if p[-1] == END_CMD:
+                self.malformed += 1
+                self.pending = bytearray()
+            return None
+
+        nparams = OPCODES[opcode][1]
+        if len(p) < 2 + nparams + 1:
+            return None
+
+        if opcode == 13:
+            # The bitmap filename is terminated by the end byte.
+            if p[-1] != END_CMD:
+                return None
+            filename = bytes(p[2 + nparams:-1]).decode("latin-1")
+            cmd = Command(self.pending_time, opcode, p[2:2 + nparams], filename=filename)
+        else:
+            if p[2 + nparams] != END_CMD:
+                self.malformed += 1
+                self.pending = bytearray()
+                return None
+            cmd = Command(self.pending_time, opcode, p[2:2 + nparams])
+        cmd.size = len(p)
+        self.pending = bytearray()
+        return cmd
+
+
+class Frame:
+    """All the commands between two frame markers."""
+
+    def __init__(self, index):
+        self.index = index
+        self.start = None
+        self.end = None
+        self.commands = []
+        self.bytes = 0
+        self.flushes = 0
+        self.flush_time = 0
+
+
+def decode(path):
+    """Decode a capture log into a list of frames.
+    Frames are split on markFrame() records if there are any, or on flush() otherwise."""
+    records = read_records(path)
+    use_frame_marks = any(r.kind == RECORD_FRAME for r in records)
+    split_kind = RECORD_FRAME if use_frame_marks else RECORD_FLUSH
+
+    parser = CommandParser()
+    frames = [Frame(0)]
+
+    def note_time(t):
+        frame = frames[-1]
+        if frame.start is None:
+            frame.start = t
+        frame.end = t
+
+    for r in records:
+        frame = frames[-1]
+        if r.kind == RECORD_DATA:
+            note_time(r.time)
+            frame.bytes += len(r.data)
+            frame.commands.extend(parser.feed(r.data, r.time))
+        elif r.kind == RECORD_FLUSH:
+            note_time(r.time + r.duration)
+            frame.flushes += 1
+            frame.flush_time += r.duration
+        if r.kind == split_kind:
+            frame.commands.extend(parser.end_text())
+            frames.append(Frame(len(frames)))
+
+    frames[-1].commands.extend(parser.finish())
+    if not frames[-1].commands and frames[-1].bytes == 0 and len(frames) > 1:
+        frames.pop()
+    return frames, parser.malformed
+
+
+#------------------------------------------------------------------------------
+# Redundancy analysis.
+
+class StateTracker:
+    """Tracks the display state to find commands which have no visible effect."""
+
+    def __init__(self):
+        self.fg = None
+        self.bg = None
+        self.rotation = None
+        self.font = None
+        self.backlight = None
+        self.cursor = None
+        self.cursor_moved = False
+
+    def check(self, cmd):
+        """Update the state for a command. Returns a reason string if it was redundant."""
+        op = cmd.opcode
+        reason = None
+        if op in (1, 2, 3, 4, 14):
+            attr = {1: "fg", 2: "bg", 3: "rotation", 4: "font", 14: "backlight"}[op]
+            if getattr(self, attr) == cmd.params[0]:
+                reason = "%s already set" % cmd.name()
+            setattr(self, attr, cmd.params[0])
+        elif op in (5, 6, 7):
+            if self.cursor_moved:
+                reason = "cursor moved again before any text"
+            self.cursor = (op, cmd.params)
+            self.cursor_moved = True
+        elif op is None:
+            self.cursor_moved = False
+        return reason
+
+
+def draw_key(cmd, tracker):
+    """A key identifying a drawing command and the colours it would use."""
+    if cmd.opcode is None:
+        return (None, tracker.cursor, cmd.text, tracker.fg, tracker.bg)
+    if cmd.opcode in DRAW_OPCODES:
+        return (cmd.opcode, cmd.params, cmd.filename, tracker.fg, tracker.bg)
+    return None
+
+
+#------------------------------------------------------------------------------
+# Reference rasteriser.
+
+class Rasteriser:
+    """Draws protocol commands into a framebuffer, following the display firmware.
+    Text is drawn as solid blocks, as the firmware's font isn't available here.
+    The framebuffer is always landscape. The direction of the portrait rotations
+    is nominal, as it can't be checked without the hardware."""
+
+    def __init__(self):
+        self.fb = bytearray(PANEL_WIDTH * PANEL_HEIGHT)
+        self.fg = 7
+        self.bg = 0
+        self.rotation = 3
+        self.font = 2
+        self.cx = 0
+        self.cy = 0
+
+    def size(self):
+        if self.rotation in (0, 2):
+            return PANEL_HEIGHT, PANEL_WIDTH
+        return PANEL_WIDTH, PANEL_HEIGHT
+
+    def plot(self, x, y, col):
+        w, h = self.size()
+        if x < 0 or y < 0 or x >= w or y >= h:
+            return
+        if self.rotation == 3:
+            px, py = x, y
+        elif self.rotation == 1:
+            px, py = PANEL_WIDTH - 1 - x, PANEL_HEIGHT - 1 - y
+        elif self.rotation == 2:
+            px, py = y, PANEL_HEIGHT - 1 - x
+        else:
+            px, py = PANEL_WIDTH - 1 - y, x
+        self.fb[py * PANEL_WIDTH + px] = col
+
+    def fill_rect(self, x1, y1, x2, y2, col):
+        for y in range(min(y1, y2), max(y1, y2) + 1):
+            for x in range(min(x1, x2), max(x1, x2) + 1):
+                self.plot(x, y, col)
+
+    def line(self, x1, y1, x2, y2, col):
+        dx = abs(x2 - x1)
+        dy = -abs(y2 - y1)
+        sx = 1 if x1 < x2 else -1
+        sy = 1 if y1 < y2 else -1
+        err = dx + dy
+        while True:
+            self.plot(x1, y1, col)
+            if x1 == x2 and y1 == y2:
+                return
+            e2 = 2 * err
+            if e2 >= dy:
+                err += dy
+                x1 += sx
+            if e2 <= dx:
+                err += dx
+                y1 += sy
+
+    def circle(self, cx, cy, r, col, filled):
+        x = r
+        y = 0
+        err = 1 - r
+        while x >= y:
+            if filled:
+                for (a, b) in ((x, y), (y, x)):
+                    for xx in range(cx - a, cx + a + 1):
+                        self.plot(xx, cy + b, col)
+                        self.plot(xx, cy - b, col)
+            else:
+                for (a, b) in ((x, y), (y, x), (-y, x), (-x, y), (-x, -y), (-y, -x), (y, -x), (x, -y)):
+                    self.plot(cx + a, cy + b, col)
+            y += 1
+            if err < 0:
+                err += 2 * y + 1
+            else:
+                x -= 1
+                err += 2 * (y - x) + 1
+
+    def text(self, data):
+        w, h = self.size()
+        cw = CHAR_WIDTH * self.font
+        ch = CHAR_HEIGHT * self.font
+        for b in data:
+            if b == 0x0A:
+                self.cx = 0
+                self.cy += ch
+                continue
+            if b == 0x0D:
+                self.cx = 0
+                continue
+            if self.cx + cw > w:
+                self.cx = 0
+                self.cy += ch
+            if self.cy + ch > h:
+                # The firmware wraps back to the top rather than scrolling.
+                self.cy = 0
+            self.fill_rect(self.cx, self.cy, self.cx + cw - 1, self.cy + ch - 1, self.bg)
+            if b != 0x20:
+                # Leave a gap on the right and bottom, like a real glyph.
+                self.fill_rect(self.cx, self.cy, self.cx + cw - 1 - self.font, self.cy + ch - 1 - self.font, self.fg)
+            self.cx += cw
+
+    def apply(self, cmd):
+        op = cmd.opcode
+        p = cmd.params
+        if op is None:
+            self.text(cmd.text)
+        elif op == 0:
+            for i in range(len(self.fb)):
+                self.fb[i] = self.bg
+            self.cx = 0
+            self.cy = 0
+        elif op == 1:
+            self.fg = p[0] & 7
+        elif op == 2:
+            self.bg = p[0] & 7
+        elif op == 3:
+            self.rotation = p[0] & 3
+        elif op == 4:
+            if p[0] in FONT_NAMES:
+                self.font = p[0]
+        elif op == 5:
+            self.cx = 0
+        elif op == 6:
+            self.cx = p[0] * CHAR_WIDTH * self.font
+            self.cy = p[1] * CHAR_HEIGHT * self.font
+        elif op == 7:
+            self.cx, self.cy = p[0], p[1]
+        elif op == 8:
+            self.line(p[0], p[1], p[2], p[3], self.fg)
+        elif op == 9:
+            self.line(p[0], p[1], p[2], p[1], self.fg)
+            self.line(p[0], p[3], p[2], p[3], self.fg)
+            self.line(p[0], p[1], p[0], p[3], self.fg)
+            self.line(p[2], p[1], p[2], p[3], self.fg)
+        elif op == 10:
+            self.fill_rect(p[0], p[1], p[2], p[3], self.fg)
+        elif op == 11:
+            self.circle(p[0], p[1], p[2], self.fg, False)
+        elif op == 12:
+            self.circle(p[0], p[1], p[2], self.fg, True)
+        elif op == 13:
+            # The bitmap comes from the display's SD card, so just mark where it goes.
+            self.line(p[0], p[1], p[0] + 7, p[1] + 7, self.fg)
+            self.line(p[0] + 7, p[1], p[0], p[1] + 7, self.fg)
+
+    def write_png(self, path):
+        rows = bytearray()
+        for y in range(PANEL_HEIGHT):
+            rows.append(0)
+            for x in range(PANEL_WIDTH):
+                rows.extend(COLOUR_RGB[self.fb[y * PANEL_WIDTH + x]])
+
+        def chunk(kind, data):
+            body = kind + data
+            return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+        header = struct.pack(">IIBBBBB", PANEL_WIDTH, PANEL_HEIGHT, 8, 2, 0, 0, 0)
+        with open(path, "wb") as f:
+            f.write(b"\x89PNG\r\n\x1a\n")
+            f.write(chunk(b"IHDR", header))
+            f.write(chunk(b"IDAT", zlib.compress(bytes(rows), 9)))
+            f.write(chunk(b"IEND", b""))
+
+
+#------------------------------------------------------------------------------
+# Commands.
+
+def cmd_trace(args):
+    frames, malformed = decode(args.capture)
+    tracker = StateTracker()
+    for frame in frames:
+        print("--- frame %d ---" % frame.index)
+        for cmd in frame.commands:
+            reason = tracker.check(cmd)
+            line = "%10.3f ms  %s" % (cmd.time / 1000.0, cmd.describe())
+            if reason:
+                line += "    [redundant: %s]" % reason
+            print(line)
+    if malformed:
+        print("warning: %d malformed commands were skipped" % malformed, file=sys.stderr)
+
+
+def cmd_stats(args):
+    frames, malformed = decode(args.capture)
+    tracker = StateTracker()
+    prev_draws = set()
+    total_bytes = 0
+    total_redundant = 0
+
+    print("frame  start_ms  span_ms  bytes  wire_ms  flush_ms  cmds  redundant  repeated")
+    for frame in frames:
+        redundant = 0
+        redundant_bytes = 0
+        repeated = 0
+        draws = set()
+        by_name = {}
+        for cmd in frame.commands:
+            if tracker.check(cmd):
+                redundant += 1
+                redundant_bytes += cmd.size
+            key = draw_key(cmd, tracker)
+            if key is not None:
+                if cmd.opcode == 0:
+                    # Everything drawn before a clear is gone.
+                    draws = set()
+                elif key in prev_draws:
+                    repeated += 1
+                draws.add(key)
+            count, size = by_name.get(cmd.name(), (0, 0))
+            by_name[cmd.name()] = (count + 1, size + cmd.size)
+        prev_draws = draws
+
+        start = frame.start or 0
+        span = (frame.end or start) - start
+        wire = frame.bytes * 10.0 * 1000.0 / args.baud
+        print("%5d  %8.1f  %7.1f  %5d  %7.1f  %8.1f  %4d  %4d (%3dB)  %8d" % (
+            frame.index, start / 1000.0, span / 1000.0, frame.bytes, wire,
+            frame.flush_time / 1000.0, len(frame.commands), redundant, redundant_bytes, repeated))
+        if args.verbose:
+            for name in sorted(by_name, key=lambda n: -by_name[n][1]):
+                count, size = by_name[name]
+                print("         %-24s %5d cmds %6d bytes" % (name, count, size))
+        total_bytes += frame.bytes
+        total_redundant += redundant_bytes
+
+    print()
+    print("frames: %d  bytes: %d  redundant bytes: %d" % (len(frames), total_bytes, total_redundant))
+    print("wire_ms assumes %d baud, 8N1. 'repeated' counts draws identical to one in the" % args.baud)
+    print("previous frame, which may be static content that doesn't need redrawing.")
+    if malformed:
+        print("warning: %d malformed commands were skipped" % malformed, file=sys.stderr)
+
+
+def cmd_render(args):
+    frames, malformed = decode(args.capture)
+    os.makedirs(args.out, exist_ok=True)
+    raster = Rasteriser()
+    written = 0
+    for frame in frames:
+        for cmd in frame.commands:
+            raster.apply(cmd)
+        if args.last and frame is not frames[-1]:
+            continue
+        if frame.index % args.every != 0 and frame is not frames[-1]:
+            continue
+        raster.write_png(os.path.join(args.out, "frame_%05d.png" % frame.index))
+        written += 1
+    print("wrote %d images to %s" % (written, args.out))
+    if malformed:
+        print("warning: %d malformed commands were skipped" % malformed, file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode HSTCaptureStream logs.")
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+
+    p = sub.add_parser("trace", help="print every command sent to the display")
+    p.add_argument("capture", help="capture log file")
+    p.set_defaults(func=cmd_trace)
+
+    p = sub.add_parser("stats", help="print statistics for each frame")
+    p.add_argument("capture", help="capture log file")
+    p.add_argument("--baud", type=int, default=9600, help="serial speed, for estimating wire time")
+    p.add_argument("-v", "--verbose", action="store_true", help="break down each frame by command")
+    p.set_defaults(func=cmd_stats)
+
+    p = sub.add_parser("render", help="render frames to PNG images")
+    p.add_argument("capture", help="capture log file")
+    p.add_argument("--out", default="frames", help="output directory")
+    p.add_argument("--every", type=positive_int, default=1, help="only write every Nth frame")
+    p.add_argument("--last", action="store_true", help="only write the final frame")
+    p.set_defaults(func=cmd_render)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (IOError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())